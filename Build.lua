@@ -8,10 +8,49 @@ workspace "GBC Emulator"
    filter "system:windows"
       buildoptions { "/EHsc", "/Zc:preprocessor", "/Zc:__cplusplus" }
 
+   filter "options:eager-flags"
+      defines { "GBC_EAGER_FLAGS" }
+
+   filter "options:io-stats"
+      defines { "GBC_IO_STATS" }
+
+   filter {}
+
+newoption {
+   trigger = "switch-dispatch",
+   description = "Build the CPU with the switch interpreter only, without the threaded core"
+}
+
+newoption {
+   trigger = "eager-flags",
+   description = "Build the CPU computing every flag as it is written instead of on demand"
+}
+
+newoption {
+   trigger = "io-stats",
+   description = "Count accesses to every I/O register, printed by EmulatorHeadless"
+}
+
+newoption {
+   trigger = "no-jit",
+   description = "Build the CPU without the x86-64 block translator"
+}
+
 OutputDir = "%{cfg.system}-%{cfg.architecture}/%{cfg.buildcfg}"
 
 include "EmulatorCore/Build-Core.lua"
 
-include "EmulatorApp/Build-App.lua"
+-- The app needs the PixieUI submodule, headless builds work without it.
+local hasPixieUI = os.isfile("dependencies/PixieUI/Build-PixieUI.lua")
+
+if hasPixieUI then
+   include "EmulatorApp/Build-App.lua"
+end
+
+include "EmulatorBench/Build-Bench.lua"
+
+include "EmulatorHeadless/Build-Headless.lua"
 
-include "dependencies/PixieUI/Build-PixieUI.lua"
\ No newline at end of file
+if hasPixieUI then
+   include "dependencies/PixieUI/Build-PixieUI.lua"
+end
\ No newline at end of file
@@ -132,23 +132,15 @@ void EmulatorWindow::HandleKeyEvent(int32_t key, int32_t scancode, int32_t actio
 
 bool EmulatorWindow::LoadROM(const std::string& romPath) {
 	std::cout << "Loading rom: \"" << romPath << "\"\n";
-	std::ifstream reader(romPath, std::ios::in | std::ifstream::binary | std::fstream::ate);
-	if (!reader) {
+	std::shared_ptr<const ROMImage> rom = ROMImage::Open(romPath);
+	if (!rom) {
 		std::cout << "Could not open ROM file: \"" << romPath << "\"\n";
 		return false;
 	}
 
-	uint32_t romSize = (uint32_t)reader.tellg();
-	uint8_t* ROMdata = new uint8_t[romSize];
-	reader.seekg(0, reader.beg);
-	reader.read((char*)ROMdata, romSize);
-	reader.close();
-
-	bool loaded = m_emulator.LoadROM(ROMdata, romSize);
+	bool loaded = m_emulator.LoadROM(rom);
 	m_emulator.SetName(std::filesystem::path(romPath).filename().string());
 
-	delete[] ROMdata;
-
 	return loaded;
 }
 
@@ -365,7 +357,7 @@ void EmulatorWindow::UpdateScreen() {
 		m_emulator.ppu.frameBuffers[!m_emulator.ppu.activeFrame].width,
 		m_emulator.ppu.frameBuffers[!m_emulator.ppu.activeFrame].height,
 		m_emulator.ppu.frameBuffers[!m_emulator.ppu.activeFrame].pixels.data(),
-		GL_RGB, GL_FLOAT
+		GL_RGBA, GL_UNSIGNED_BYTE
 	);
 	
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
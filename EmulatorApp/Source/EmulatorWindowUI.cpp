@@ -161,12 +161,7 @@ EmulatorWindowUI::~EmulatorWindowUI() {
 }
 
 void EmulatorWindowUI::UploadViewportTexture(uint32_t width, uint32_t height, void* data, GLenum format, GLenum type) {
-	m_viewportTexture->UploadTexture(
-		m_emulator.ppu.frameBuffers[!m_emulator.ppu.activeFrame].width,
-		m_emulator.ppu.frameBuffers[!m_emulator.ppu.activeFrame].height,
-		m_emulator.ppu.frameBuffers[!m_emulator.ppu.activeFrame].pixels.data(),
-		GL_RGB, GL_FLOAT
-	);
+	m_viewportTexture->UploadTexture(width, height, data, format, type);
 }
 
 void EmulatorWindowUI::Draw() {
@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "GBCEmulator.h"
+#include "Log.h"
+#include "PixelKernels.h"
+
+struct Benchmark {
+	std::string name;
+	std::function<void(GBCEmulator&)> configure;
+};
+
+const std::vector<Benchmark> benchmarks = {
+	{ "lockstep", [](GBCEmulator& emulator) { emulator.syncMode = SyncMode::Lockstep; } },
+	{ "scheduled", [](GBCEmulator& emulator) { emulator.syncMode = SyncMode::Scheduled; } },
+	{ "scheduled-noidle", [](GBCEmulator& emulator) { emulator.cpu.skipIdleLoops = false; } },
+	{ "scheduled-cached", [](GBCEmulator& emulator) { emulator.cpu.dispatch = CPUDispatch::Cached; } },
+	{ "scheduled-jit", [](GBCEmulator& emulator) { emulator.cpu.dispatch = CPUDispatch::JIT; } },
+};
+
+// Loop of register, memory, stack and CB-prefixed instructions that never
+// touches I/O, so the CPU can run without the other components.
+std::vector<uint8_t> CreateMixedProgram() {
+	return {
+		0x31, 0x00, 0xd0, // ld SP, $d000
+		0x21, 0x00, 0xc0, // ld HL, $c000
+		0x78, // loop: ld A, B
+		0x81, // add A, C
+		0xaa, // xor A, D
+		0x1c, // inc E
+		0x22, // ld [HL+], A
+		0x7e, // ld A, [HL]
+		0xcb, 0x00, // rlc B
+		0xcb, 0x7f, // bit 7, A
+		0x0b, // dec BC
+		0x26, 0xc0, // ld H, $c0
+		0xc5, // push BC
+		0xd1, // pop DE
+		0xfe, 0x40, // cp A, $40
+		0x20, 0x01, // jr NZ, skip
+		0x3c, // inc A
+		0x18, 0xea, // skip: jr loop
+	};
+}
+
+// Loop of 8-bit arithmetic whose flags are mostly overwritten before a
+// conditional jump or carry reads them.
+std::vector<uint8_t> CreateALUProgram() {
+	return {
+		0x06, 0x00, // loop: ld B, $00
+		0x80, // inner: add A, B
+		0x89, // adc A, C
+		0x92, // sub A, D
+		0xa3, // and A, E
+		0xb1, // or A, C
+		0x0c, // inc C
+		0x9b, // sbc A, E
+		0xaa, // xor A, D
+		0x14, // inc D
+		0xc6, 0x11, // add A, $11
+		0x1d, // dec E
+		0xb8, // cp A, B
+		0x3c, // inc A
+		0x05, // dec B
+		0x20, 0xef, // jr NZ, inner
+		0x18, 0xeb, // jr loop
+	};
+}
+
+// Switches the ROM bank at 0x4000 and reads from it on every iteration.
+std::vector<uint8_t> CreateBankSwitchProgram() {
+	return {
+		0x21, 0x00, 0x40, // ld HL, $4000
+		0x06, 0x01, // ld B, $01
+		0x78, // loop: ld A, B
+		0xea, 0x00, 0x20, // ld [$2000], A
+		0x86, // add A, [HL]
+		0x4f, // ld C, A
+		0x04, // inc B
+		0x18, 0xf7, // jr loop
+	};
+}
+
+// Streams tiles every frame like a CGB game: a 2 KiB GDMA from ROM bank 1 at
+// the start of VBlank, then a 1152 byte HBlank DMA over the next frame.
+std::vector<uint8_t> CreateTileStreamProgram() {
+	return {
+		0xf0, 0x44, // vblank: ldh A, [LY]
+		0xfe, 0x90, // cp A, 144
+		0x20, 0xfa, // jr NZ, vblank
+		0x3e, 0x40, // ld A, $40
+		0xe0, 0x51, // ldh [HDMA1], A
+		0xaf, // xor A
+		0xe0, 0x52, // ldh [HDMA2], A
+		0xe0, 0x53, // ldh [HDMA3], A
+		0xe0, 0x54, // ldh [HDMA4], A
+		0x3e, 0x7f, // ld A, $7f
+		0xe0, 0x55, // ldh [HDMA5], A
+		0x3e, 0x48, // ld A, $48
+		0xe0, 0x51, // ldh [HDMA1], A
+		0x3e, 0x08, // ld A, $08
+		0xe0, 0x53, // ldh [HDMA3], A
+		0x3e, 0xc7, // ld A, $c7
+		0xe0, 0x55, // ldh [HDMA5], A
+		0xf0, 0x44, // visible: ldh A, [LY]
+		0xfe, 0x90, // cp A, 144
+		0x28, 0xfa, // jr Z, visible
+		0x18, 0xd7, // jr vblank
+	};
+}
+
+struct CPUBenchmark {
+	std::string name;
+	CPUDispatch dispatch;
+	std::vector<uint8_t> (*createProgram)();
+	uint8_t cartridgeType = 0x00;
+};
+
+const std::vector<CPUBenchmark> cpuBenchmarks = {
+	{ "cpu-switch", CPUDispatch::Switch, CreateMixedProgram },
+	{ "cpu-cached", CPUDispatch::Cached, CreateMixedProgram },
+	{ "cpu-threaded", CPUDispatch::Threaded, CreateMixedProgram },
+	{ "cpu-jit", CPUDispatch::JIT, CreateMixedProgram },
+	{ "alu-switch", CPUDispatch::Switch, CreateALUProgram },
+	{ "alu-cached", CPUDispatch::Cached, CreateALUProgram },
+	{ "alu-threaded", CPUDispatch::Threaded, CreateALUProgram },
+	{ "alu-jit", CPUDispatch::JIT, CreateALUProgram },
+	{ "bank-mbc1-cached", CPUDispatch::Cached, CreateBankSwitchProgram, 0x01 },
+	{ "bank-mbc5-switch", CPUDispatch::Switch, CreateBankSwitchProgram, 0x19 },
+	{ "bank-mbc5-cached", CPUDispatch::Cached, CreateBankSwitchProgram, 0x19 },
+	{ "bank-mbc5-jit", CPUDispatch::JIT, CreateBankSwitchProgram, 0x19 },
+};
+
+// Cartridges with a mapper get 8 banks of 16 KiB, each starting with its number.
+std::vector<uint8_t> CreateCPUBenchmarkROM(const std::vector<uint8_t>& program, uint8_t cartridgeType) {
+	std::vector<uint8_t> rom(cartridgeType ? 0x20000 : 0x8000, 0);
+	const std::vector<uint8_t> entry = { 0x00, 0xc3, 0x50, 0x01 }; // nop; jp $0150
+	std::copy(entry.begin(), entry.end(), rom.begin() + 0x100);
+	if (cartridgeType) {
+		rom[0x147] = cartridgeType;
+		rom[0x148] = 0x02;
+		for (uint32_t bank = 1; bank < 8; bank++) {
+			rom[bank * 0x4000] = (uint8_t)bank;
+		}
+	}
+	std::copy(program.begin(), program.end(), rom.begin() + 0x150);
+	return rom;
+}
+
+double RunBenchmark(const Benchmark& benchmark, std::shared_ptr<const ROMImage> rom, uint32_t frames, uint64_t& idleCycles) {
+	GBCEmulator* emulator = new GBCEmulator();
+	benchmark.configure(*emulator);
+
+	// Keep core logging out of the measurements.
+	SetCoreLog(nullptr);
+	emulator->LoadROM(rom);
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < frames; i++) {
+		emulator->Run(GBCEmulator::FrameCycles);
+		emulator->spu.ClearSamples();
+	}
+	auto end = std::chrono::steady_clock::now();
+	idleCycles = emulator->cpu.idleCyclesSkipped;
+	SetCoreLog(&std::cout);
+
+	delete emulator;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+double RunTileStreamBenchmark(uint32_t frames, uint64_t& bytes) {
+	std::vector<uint8_t> rom = CreateCPUBenchmarkROM(CreateTileStreamProgram(), 0x19);
+	for (uint32_t i = 0x4001; i < 0x8000; i++) {
+		rom[i] = (uint8_t)(i * 7);
+	}
+	GBCEmulator* emulator = new GBCEmulator();
+	SetCoreLog(nullptr);
+	emulator->LoadROM(rom.data(), (uint32_t)rom.size());
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < frames; i++) {
+		emulator->Run(GBCEmulator::FrameCycles);
+		emulator->spu.ClearSamples();
+	}
+	auto end = std::chrono::steady_clock::now();
+	SetCoreLog(&std::cout);
+
+	// Both transfers end in tile data copied from bank 1.
+	bytes = 0;
+	for (uint16_t address = 0x8000; address < 0x8c80; address++) {
+		bytes += emulator->bus.Read8(address) == rom[0x4000 + (address - 0x8000)];
+	}
+	delete emulator;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+double RunCPUBenchmark(const CPUBenchmark& benchmark, std::vector<uint8_t>& rom, uint64_t cycles, uint64_t& instructions) {
+	GBCEmulator* emulator = new GBCEmulator();
+	SetCoreLog(nullptr);
+	emulator->LoadROM(rom.data(), (uint32_t)rom.size());
+	emulator->cpu.dispatch = benchmark.dispatch;
+	// Without deadlines the CPU only stops at the requested budget.
+	emulator->scheduler.Reset();
+
+	uint64_t startInstructions = emulator->cpu.instructions;
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t elapsed = 0; elapsed < cycles;) {
+		elapsed += emulator->cpu.Run(GBCEmulator::FrameCycles);
+	}
+	auto end = std::chrono::steady_clock::now();
+	instructions = emulator->cpu.instructions - startInstructions;
+	SetCoreLog(&std::cout);
+
+	delete emulator;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+// Decodes every tile of a VRAM bank once per frame. The output is compared
+// against the scalar kernel.
+double RunDecodeBenchmark(const PixelKernels& kernels, uint32_t frames, bool& matches) {
+	std::vector<uint8_t> data(TileCache::TileDataSize);
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = (uint8_t)(i * 113 + (i >> 5));
+	}
+	std::vector<uint8_t> pixels(TileCache::TileCount * 64), flipped(pixels.size());
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t frame = 0; frame < frames; frame++) {
+		for (uint32_t tile = 0; tile < TileCache::TileCount; tile++) {
+			kernels.decodeTile(&data[tile * 16], &pixels[tile * 64], &flipped[tile * 64]);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	std::vector<uint8_t> expectedPixels(pixels.size()), expectedFlipped(pixels.size());
+	const PixelKernels& scalar = PixelKernels::Get(SIMDLevel::Scalar);
+	for (uint32_t tile = 0; tile < TileCache::TileCount; tile++) {
+		scalar.decodeTile(&data[tile * 16], &expectedPixels[tile * 64], &expectedFlipped[tile * 64]);
+	}
+	matches = pixels == expectedPixels && flipped == expectedFlipped;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+// Converts the 144 lines of a frame from palette indices to packed pixels.
+double RunExpandBenchmark(const PixelKernels& kernels, PixelFormat format, uint32_t frames, bool& matches) {
+	const uint32_t width = PPU::screenWidth, height = PPU::screenHeight;
+	PaletteTable palette;
+	palette.format = format;
+	for (uint32_t i = 0; i < 12; i++) {
+		palette.Set(i, FrameBuffer::Pack(format, (uint8_t)(i * 20), (uint8_t)(255 - i * 20), (uint8_t)(i * 7), (uint8_t)i));
+	}
+	std::vector<uint8_t> indices(width * height);
+	for (size_t i = 0; i < indices.size(); i++) {
+		indices[i] = (uint8_t)((i * 7 + (i >> 3)) % 12);
+	}
+	FrameBuffer frame(width, height, format), expected(width, height, format);
+	uint32_t pitch = width * FrameBuffer::BytesPerPixel(format);
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < frames; i++) {
+		for (uint32_t y = 0; y < height; y++) {
+			kernels.expandPalette(&indices[y * width], width, palette, &frame.pixels[y * pitch]);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	for (uint32_t y = 0; y < height; y++) {
+		PixelKernels::Get(SIMDLevel::Scalar).expandPalette(&indices[y * width], width, palette, &expected.pixels[y * pitch]);
+	}
+	matches = frame.pixels == expected.pixels;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+// Creates instances that all map the same ROM image, as the batch runner does.
+double RunStartupBenchmark(std::shared_ptr<const ROMImage> rom, uint32_t count) {
+	std::vector<GBCEmulator*> emulators(count);
+	SetCoreLog(nullptr);
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < count; i++) {
+		emulators[i] = new GBCEmulator();
+		emulators[i]->LoadROM(rom);
+	}
+	auto end = std::chrono::steady_clock::now();
+	SetCoreLog(&std::cout);
+
+	for (GBCEmulator* emulator : emulators) {
+		delete emulator;
+	}
+	return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::cout << "Usage: EmulatorBench <rom> [frames] [benchmark]\n";
+		return 1;
+	}
+
+	std::shared_ptr<const ROMImage> rom = ROMImage::Open(argv[1]);
+	if (!rom) {
+		std::cout << "Could not open ROM file: \"" << argv[1] << "\"\n";
+		return 1;
+	}
+	uint32_t frames = argc > 2 ? std::stoul(argv[2]) : 600;
+	std::string filter = argc > 3 ? argv[3] : "";
+
+	uint64_t cpuCycles = (uint64_t)frames * GBCEmulator::FrameCycles;
+	std::cout << std::left << std::setw(24) << "benchmark" << std::right << std::setw(12) << "frames/s" << std::setw(12) << "speed" << std::setw(12) << "idle" << "\n";
+	for (const Benchmark& benchmark : benchmarks) {
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+		uint64_t idleCycles = 0;
+		double seconds = RunBenchmark(benchmark, rom, frames, idleCycles);
+		double fps = frames / seconds;
+		std::cout << std::left << std::setw(24) << benchmark.name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << fps << std::setw(11) << fps / 60.0 << "x" << std::setw(11) << idleCycles * 100.0 / cpuCycles << "%\n";
+	}
+
+	std::cout << "\n" << std::left << std::setw(24) << "benchmark" << std::right << std::setw(12) << "MIPS" << "\n";
+	for (const CPUBenchmark& benchmark : cpuBenchmarks) {
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+		uint64_t instructions = 0;
+		std::vector<uint8_t> cpuROM = CreateCPUBenchmarkROM(benchmark.createProgram(), benchmark.cartridgeType);
+		double seconds = RunCPUBenchmark(benchmark, cpuROM, cpuCycles, instructions);
+		std::cout << std::left << std::setw(24) << benchmark.name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << instructions / seconds / 1000000.0 << "\n";
+	}
+
+	if (filter.empty() || std::string("tiles").find(filter) != std::string::npos) {
+		uint64_t bytes = 0;
+		double seconds = RunTileStreamBenchmark(frames, bytes);
+		double fps = frames / seconds;
+		std::cout << "\n" << std::left << std::setw(24) << "benchmark" << std::right << std::setw(12) << "frames/s" << std::setw(12) << "speed" << std::setw(12) << "copied" << "\n"
+			<< std::left << std::setw(24) << "tiles-gdma-hdma" << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << fps << std::setw(11) << fps / 60.0 << "x" << std::setw(12) << bytes << "\n";
+	}
+
+	if (filter.empty() || std::string("kernels").find(filter) != std::string::npos) {
+		std::cout << "\n" << std::left << std::setw(24) << "kernels" << std::right << std::setw(12) << "Mpixels/s" << std::setw(12) << "matches" << "\n";
+		std::vector<std::pair<std::string, PixelFormat>> formats = { { "rgba8", PixelFormat::RGBA8 }, { "rgb565", PixelFormat::RGB565 }, { "index8", PixelFormat::Index8 } };
+		for (SIMDLevel level : { SIMDLevel::Scalar, SIMDLevel::SSSE3, SIMDLevel::AVX2 }) {
+			const PixelKernels& kernels = PixelKernels::Get(level);
+			if (kernels.level != level) continue;
+			bool matches = false;
+			double seconds = RunDecodeBenchmark(kernels, frames, matches);
+			std::cout << std::left << std::setw(24) << std::string("decode-") + kernels.name << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(12) << frames * TileCache::TileCount * 64.0 / seconds / 1000000.0 << std::setw(12) << (matches ? "yes" : "no") << "\n";
+			for (const auto& [formatName, format] : formats) {
+				seconds = RunExpandBenchmark(kernels, format, frames, matches);
+				std::cout << std::left << std::setw(24) << "expand-" + formatName + "-" + kernels.name << std::right << std::fixed << std::setprecision(1)
+					<< std::setw(12) << frames * (double)PPU::screenWidth * PPU::screenHeight / seconds / 1000000.0 << std::setw(12) << (matches ? "yes" : "no") << "\n";
+			}
+		}
+	}
+
+	if (filter.empty() || std::string("startup").find(filter) != std::string::npos) {
+		const uint32_t instances = 256;
+		double seconds = RunStartupBenchmark(rom, instances);
+		std::cout << "\n" << std::left << std::setw(24) << "startup" << std::right << std::setw(12) << "loads/s" << "\n"
+			<< std::left << std::setw(24) << (rom->IsMapped() ? "shared-mapped" : "shared-copied") << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << instances / seconds << "\n";
+	}
+	return 0;
+}
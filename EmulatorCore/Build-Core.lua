@@ -5,7 +5,7 @@ project "EmulatorCore"
    targetdir "build/%{cfg.buildcfg}"
    staticruntime "off"
 
-   files { "Source/**.h", "Source/**.cpp" }
+   files { "Source/**.h", "Source/**.inl", "Source/**.cpp" }
 
    includedirs
    {
@@ -19,6 +19,12 @@ project "EmulatorCore"
        systemversion "latest"
        defines { }
 
+   filter "options:switch-dispatch"
+       defines { "GBC_SWITCH_DISPATCH" }
+
+   filter "options:no-jit"
+       defines { "GBC_NO_JIT" }
+
    filter "configurations:Debug"
        defines { "DEBUG" }
        runtime "Debug"
@@ -0,0 +1,79 @@
+#include "BatchRunner.h"
+#include "Log.h"
+#include <chrono>
+
+BatchRunner::BatchRunner(uint32_t threads) : pool(threads) {}
+
+uint32_t BatchRunner::GetThreadCount() const {
+	return pool.GetThreadCount();
+}
+
+std::vector<BatchResult> BatchRunner::Run(const std::vector<BatchInstance>& instances, uint32_t frames) {
+	std::vector<BatchResult> results(instances.size());
+	std::vector<Session> sessions(instances.size());
+	for (size_t i = 0; i < instances.size(); i++) {
+		Session& session = sessions[i];
+		session.instance = &instances[i];
+		session.result = &results[i];
+		session.result->name = instances[i].name;
+		session.framesLeft = frames;
+		pool.Submit([this, &session] { RunSlice(&session); });
+	}
+	pool.Wait();
+	return results;
+}
+
+// FNV-1a
+uint64_t BatchRunner::Hash(const void* data, size_t size) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	}
+	return hash;
+}
+
+void BatchRunner::RunSlice(Session* session) {
+	SetCoreLog(nullptr);
+	auto start = std::chrono::steady_clock::now();
+	if (!session->emulator) {
+		session->emulator = new GBCEmulator();
+		session->emulator->cpu.dispatch = session->instance->dispatch;
+		session->emulator->SetFrameSkip(session->instance->frameSkipMode, session->instance->frameSkip, session->instance->frameSkipInterval);
+		session->result->loaded = session->emulator->LoadROM(session->instance->rom);
+		session->emulator->SetName(session->instance->name);
+		if (!session->result->loaded) session->framesLeft = 0;
+	}
+
+	uint32_t frames = session->framesLeft < FramesPerTask ? session->framesLeft : FramesPerTask;
+	for (uint32_t i = 0; i < frames; i++) {
+		session->emulator->Run(GBCEmulator::FrameCycles);
+		session->emulator->spu.ClearSamples();
+	}
+	session->framesLeft -= frames;
+	if (!session->framesLeft) Finish(*session);
+	session->result->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (session->framesLeft) {
+		pool.Submit([this, session] { RunSlice(session); });
+	}
+}
+
+void BatchRunner::Finish(Session& session) {
+	GBCEmulator& emulator = *session.emulator;
+	BatchResult& result = *session.result;
+	if (result.loaded) {
+		const FrameBuffer& frame = emulator.ppu.frameBuffers[!emulator.ppu.activeFrame];
+		result.frameHash = Hash(frame.pixels.data(), frame.ByteSize());
+		result.ram.clear();
+		for (uint32_t address = 0xc000; address < 0xe000; address++) {
+			result.ram.push_back(emulator.bus.Read8(address, true));
+		}
+		for (uint32_t address = 0xff80; address < 0xffff; address++) {
+			result.ram.push_back(emulator.bus.Read8(address, true));
+		}
+		result.ramHash = Hash(result.ram.data(), result.ram.size());
+	}
+	delete session.emulator;
+	session.emulator = nullptr;
+}
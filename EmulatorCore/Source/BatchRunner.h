@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GBCEmulator.h"
+#include "ThreadPool.h"
+
+struct BatchInstance {
+	std::string name;
+	// Shared by every instance of the same cartridge.
+	std::shared_ptr<const ROMImage> rom;
+	CPUDispatch dispatch = CPU::DefaultDispatch;
+	FrameSkipMode frameSkipMode = FrameSkipMode::Off;
+	uint32_t frameSkip = 0;
+	uint32_t frameSkipInterval = 1;
+};
+
+struct BatchResult {
+	std::string name;
+	bool loaded = false;
+	uint64_t frameHash = 0;
+	uint64_t ramHash = 0;
+	// WRAM bank 0, the mapped WRAM bank and HRAM after the last frame.
+	std::vector<uint8_t> ram;
+	double seconds = 0;
+};
+
+// Runs many emulators at once. Instances advance in slices of frames that are
+// tasks of a work-stealing pool, so long and short sessions balance across
+// threads. Core logging is muted on the workers.
+class BatchRunner {
+public:
+	static const uint32_t FramesPerTask = 60;
+
+	explicit BatchRunner(uint32_t threads);
+
+	uint32_t GetThreadCount() const;
+	std::vector<BatchResult> Run(const std::vector<BatchInstance>& instances, uint32_t frames);
+
+	static uint64_t Hash(const void* data, size_t size);
+
+private:
+	struct Session {
+		const BatchInstance* instance = nullptr;
+		GBCEmulator* emulator = nullptr;
+		BatchResult* result = nullptr;
+		uint32_t framesLeft = 0;
+	};
+
+	ThreadPool pool;
+
+	void RunSlice(Session* session);
+	void Finish(Session& session);
+};
@@ -1,24 +1,157 @@
 #include "Bus.h"
+#include "Log.h"
+#include <algorithm>
+#include <iomanip>
 
-Bus::Bus(MMC* mmc, DMA& dma, Joypad& joypad1, Timer& timer, SPU& spu, PPU& ppu, CPU& cpu)
-	: mmc(mmc), dma(dma), joypad1(joypad1), timer(timer), spu(spu), ppu(ppu), cpu(cpu) {}
+Bus::Bus(Scheduler& scheduler, Mapper& mapper, DMA& dma, Joypad& joypad1, Timer& timer, SPU& spu, PPU& ppu, CPU& cpu)
+	: scheduler(scheduler), mapper(mapper), mmc(GetMMC(mapper)), dma(dma), joypad1(joypad1), timer(timer), spu(spu), ppu(ppu), cpu(cpu) {
+	readPages.fill(nullptr);
+	writePages.fill(nullptr);
+	mappedReadPages.fill(nullptr);
+	mappedWritePages.fill(nullptr);
+	codePages.fill(false);
+}
 
 void Bus::Reset() {
-	mmc->Reset();
+	UnlockMemoryMap();
+	std::visit([](auto& mapper) { mapper.Reset(); }, mapper);
 	dma.Reset();
 	joypad1.Reset();
 	timer.Reset();
 	spu.Reset();
 	ppu.Reset();
 	cpu.Reset();
+	std::visit([](auto& mapper) { mapper.UpdateMemoryMap(); }, mapper);
+	scheduler.Reset();
+	ScheduleEvents();
+}
+
+// Bank switches remap whole 16 KiB windows, so this runs for every bank write.
+// The loops are kept branch free so they compile to plain vector stores.
+void Bus::MapPages(uint16_t address, uint32_t size, const uint8_t* readMemory, uint8_t* writeMemory) {
+	uint32_t first = address >> 8;
+	uint32_t last = (address + size - 1) >> 8;
+	uint32_t count = last - first + 1;
+	FillPages(&mappedReadPages[first], count, readMemory);
+	FillPages(&mappedWritePages[first], count, writeMemory);
+	uint32_t echoFirst = std::max(first, 0xc0u);
+	uint32_t echoLast = std::min(last, 0xddu);
+	if (echoFirst <= echoLast) {
+		std::copy(&mappedReadPages[echoFirst], &mappedReadPages[echoLast] + 1, &mappedReadPages[echoFirst + 0x20]);
+		std::copy(&mappedWritePages[echoFirst], &mappedWritePages[echoLast] + 1, &mappedWritePages[echoFirst + 0x20]);
+	}
+	if (memoryLocked) return;
+	std::copy(&mappedReadPages[first], &mappedReadPages[last] + 1, &readPages[first]);
+	if (echoFirst <= echoLast) {
+		std::copy(&mappedReadPages[echoFirst], &mappedReadPages[echoLast] + 1, &readPages[echoFirst + 0x20]);
+	}
+	if (writeMemory) {
+		for (uint32_t page = first; page <= last; page++) {
+			UpdateWritePage(page);
+		}
+	}
+	else {
+		std::fill(&writePages[first], &writePages[last] + 1, nullptr);
+		if (echoFirst <= echoLast) {
+			std::fill(&writePages[echoFirst + 0x20], &writePages[echoLast + 0x20] + 1, nullptr);
+		}
+	}
+}
+
+template <typename T>
+void Bus::FillPages(T** pages, uint32_t count, T* memory) {
+	if (!memory) {
+		std::fill(pages, pages + count, nullptr);
+		return;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		pages[i] = memory + (i << 8);
+	}
+}
+
+void Bus::UpdateWritePage(uint32_t page) {
+	uint8_t* memory = codePages[page] ? nullptr : mappedWritePages[page];
+	writePages[page] = memory;
+	if (page >= 0xc0 && page < 0xde) {
+		writePages[page + 0x20] = memory;
+	}
+}
+
+void Bus::LockMemoryMap() {
+	memoryLocked = true;
+	readPages.fill(nullptr);
+	writePages.fill(nullptr);
+}
+
+void Bus::UnlockMemoryMap() {
+	memoryLocked = false;
+	readPages = mappedReadPages;
+	writePages = mappedWritePages;
+	for (uint32_t page = 0xc0; page < 0xe0; page++) {
+		if (codePages[page]) UpdateWritePage(page);
+	}
+}
+
+void Bus::WatchCodePage(uint8_t page) {
+	if (codePages[page]) return;
+	codePages[page] = true;
+	if (!memoryLocked) UpdateWritePage(page);
+}
+
+// VRAM DMA writes bypass WriteSlow, which would synchronize the components the
+// transfer runs from. Blocks never cross a page.
+void Bus::WriteVRAMBlock(uint16_t address, const uint8_t* data, uint32_t size) {
+	uint8_t page = address >> 8;
+	if (codePages[page]) {
+		codePages[page] = false;
+		if (!memoryLocked) UpdateWritePage(page);
+		cpu.InvalidateCode(page);
+	}
+	mmc->WriteVRAMBlock(address, data, size);
+}
+
+void Bus::ClearCodePages() {
+	codePages.fill(false);
+	if (memoryLocked) return;
+	for (uint32_t page = 0xc0; page < 0xe0; page++) {
+		UpdateWritePage(page);
+	}
+}
+
+void Bus::Synchronize() {
+	uint32_t cycles = scheduler.TakePendingCycles();
+	if (cycles) {
+		timer.Synchronize();
+		dma.Step(cycles);
+		ppu.StepScanlineMode(cycles);
+	}
+	ScheduleEvents();
+}
+
+void Bus::ScheduleEvents() {
+	ScheduleEvent(SchedulerEvent::TimerOverflow, timer.CyclesUntilEvent());
+	ScheduleEvent(SchedulerEvent::DMATransfer, dma.CyclesUntilEvent());
+	ScheduleEvent(SchedulerEvent::PPUModeChange, ppu.CyclesUntilEvent());
+}
+
+void Bus::ScheduleEvent(SchedulerEvent event, uint32_t cycles) {
+	if (cycles) {
+		scheduler.Schedule(event, scheduler.Now() + cycles);
+	}
+	else {
+		scheduler.Deschedule(event);
+	}
 }
 
 void Bus::TriggerInterruption(Interruption interruption) {
 	cpu.IF |= (uint8_t)interruption;
 }
 
-uint8_t Bus::Read8(uint16_t  address, bool isDMAAccess) {
-	if (dma.active && address < 0xff80 && !isDMAAccess) {
+uint8_t Bus::ReadSlow(uint16_t address, bool isDMAAccess) {
+	if (address >= 0xff80) {
+		return address == 0xffff ? cpu.IE : mmc->ReadHRAM(address);
+	}
+	if (dma.active && !isDMAAccess) {
 		return 0xff;
 	}
 	if (address < 0xfe00) {
@@ -26,115 +159,36 @@ uint8_t Bus::Read8(uint16_t  address, bool isDMAAccess) {
 			//return 0xff;
 		}
 		if (address >= 0xe000) address -= 0x2000;
-		return mmc->Read8(address);
+		return ReadMapper(address);
 	}
 	if (address < 0xfea0) {
 		//if (ppu.LCDEnable && (ppu.PPUMode == 2 || ppu.PPUMode == 3)) return 0xff;
 		return mmc->ReadOAM(address);
 	}
 	if (address >= 0xff00) {
-		switch (address & 0xff) {
-		case 0x00:
-			return joypad1.Read();
-		case 0x01: // Serial transfer data
-		case 0x02: // Serial transfer control
-			return mmc->ReadHRAM(address);
-			return 0;
-		case 0x04:
-			return timer.ReadDIV();
-		case 0x05:
-			return timer.ReadTIMA();
-		case 0x06:
-			return timer.ReadTMA();
-		case 0x07:
-			return timer.ReadTAC();
-		case 0x0f:
-			return cpu.IF;
-		case 0x10: case 0x11: case 0x12: case 0x13: case 0x14:
-			return spu.sweepChannel.ReadRegister(address - 0xff10);
-		case 0x15: case 0x16: case 0x17: case 0x18: case 0x19:
-			return spu.toneChannel.ReadRegister(address - 0xff15);
-		case 0x1a: case 0x1b: case 0x1c: case 0x1d: case 0x1e:
-			return spu.waveChannel.ReadRegister(address - 0xff1a);
-		case 0x1f: case 0x20: case 0x21: case 0x22: case 0x23:
-			return spu.noiseChannel.ReadRegister(address - 0xff1f);
-		case 0x24:
-			return spu.ReadNR50();
-		case 0x25:
-			return spu.ReadNR51();
-		case 0x26:
-			return spu.ReadNR52();
-		case 0x30: case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x36: case 0x37:
-		case 0x38: case 0x39: case 0x3a: case 0x3b: case 0x3c: case 0x3d: case 0x3e: case 0x3f:
-			return spu.waveChannel.ReadWaveByte(address - 0xff30);
-		case 0x40:
-			return ppu.ReadLCDC();
-		case 0x41:
-			return ppu.ReadSTAT();
-		case 0x42:
-			return ppu.ReadSCY();
-		case 0x43:
-			return ppu.ReadSCX();
-		case 0x44:
-			return ppu.ReadLY();
-		case 0x45:
-			return ppu.ReadLYC();
-		case 0x46:
-			return 0x00;
-		case 0x47:
-			return ppu.ReadBGP();
-		case 0x48:
-			return ppu.ReadOBP0();
-		case 0x49:
-			return ppu.ReadOBP1();
-		case 0x4a:
-			return ppu.ReadWY();
-		case 0x4b:
-			return ppu.ReadWX();
-		case 0x4d:
-			return cpu.key1;
-		case 0x4f:
-			return mmc->ReadVBK();
-		case 0x51:
-			return 0x00;
-		case 0x52:
-			return 0x00;
-		case 0x53:
-			return 0x00;
-		case 0x54:
-			return 0x00;
-		case 0x55:
-			return dma.ReadHDMA5();
-		case 0x56: // Infrared communications port
-			return 0xff;
-		case 0x68:
-			return ppu.ReadBGPI();
-		case 0x69:
-			return ppu.ReadBGPD();
-		case 0x6a:
-			return ppu.ReadOBPI();
-		case 0x6b:
-			return ppu.ReadOBPD();
-		case 0x6c:
-			return ppu.ReadOPRI();
-		case 0x70:
-			return mmc->ReadSVBK();
-		case 0x76:
-			return spu.ReadPCM12();
-		case 0x77:
-			return spu.ReadPCM34();
-		case 0xff:
-			return cpu.IE;
-		default:
-			return mmc->ReadHRAM(address);
-		}
+		return ReadIO(address);
 	}
-	std::cout << "Unhandled read from address: 0x" << std::hex << address << "\n";
+	CoreLog() << "Unhandled read from address: 0x" << std::hex << address << "\n";
 	return 0;
 }
 
-void Bus::Write8(uint16_t address, uint8_t value, bool isDMAAccess) {
-	if (dma.active && address < 0xff80 && !isDMAAccess) {
+uint8_t Bus::ReadIO(uint16_t address) {
+	const IORegister& ioRegister = ioRegisters[address & 0x7f];
+#ifdef GBC_IO_STATS
+	ioReads[address & 0x7f]++;
+#endif
+	if (ioRegister.flags & IORegister::Synchronize) Synchronize();
+	if (ioRegister.flags & IORegister::SynchronizeAudio) spu.Synchronize();
+	return ioRegister.read(*this, address);
+}
+
+void Bus::WriteSlow(uint16_t address, uint8_t value, bool isDMAAccess) {
+	if (address >= 0xff80) {
+		if (address == 0xffff) cpu.IE = value;
+		else mmc->WriteHRAM(address, value);
+		return;
+	}
+	if (dma.active && !isDMAAccess) {
 		return;
 	}
 	if (address < 0xfe00) {
@@ -142,154 +196,58 @@ void Bus::Write8(uint16_t address, uint8_t value, bool isDMAAccess) {
 			//return;
 		}
 		if (address >= 0xe000) address -= 0x2000;
-		mmc->Write8(address, value);
+		if (address >= 0x8000 && address < 0xa000) Synchronize();
+		if (codePages[address >> 8]) {
+			WriteCode(address, value);
+			return;
+		}
+		WriteMapper(address, value);
 		return;
 	}
 	if (address < 0xfea0) {
 		//if (ppu.LCDEnable && (ppu.mode == 2 || ppu.mode == 3)) return;
+		if (!isDMAAccess) Synchronize();
 		mmc->WriteOAM(address, value);
 		return;
 	}
 	if (address >= 0xff00) {
-		switch (address & 0xff) {
-		case 0x00:
-			joypad1.Write(value);
-			return;
-		case 0x01: // Serial transfer data
-			std::cout << "Write to serial: " << std::hex << (int32_t)value << "(" << value << ")" << "\n";
-			mmc->WriteHRAM(address, value);
-			return;
-		case 0x02: // Serial transfer control
-			//std::cout << "Write to serial control: " << std::hex << (int32_t)value << "\n";
-			mmc->WriteHRAM(address, value);
-			return;
-		case 0x04:
-			timer.WriteDIV(value);
-			return;
-		case 0x05:
-			timer.WriteTIMA(value);
-			return;
-		case 0x06:
-			timer.WriteTMA(value);
-			return;
-		case 0x07:
-			timer.WriteTAC(value);
-			return;
-		case 0x0f:
-			cpu.IF = value;
-			return;
-		case 0x10: case 0x11: case 0x12: case 0x13: case 0x14:
-			spu.sweepChannel.WriteRegister(address - 0xff10, value);
-			return;
-		case 0x15: case 0x16: case 0x17: case 0x18: case 0x19:
-			spu.toneChannel.WriteRegister(address - 0xff15, value);
-			return;
-		case 0x1a: case 0x1b: case 0x1c: case 0x1d: case 0x1e:
-			spu.waveChannel.WriteRegister(address - 0xff1a, value);
-			return;
-		case 0x1f: case 0x20: case 0x21: case 0x22: case 0x23:
-			spu.noiseChannel.WriteRegister(address - 0xff1f, value);
-			return;
-		case 0x24:
-			spu.WriteNR50(value);
-			return;
-		case 0x25:
-			spu.WriteNR51(value);
-			return;
-		case 0x26:
-			spu.WriteNR52(value);
-			return;
-		case 0x30: case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x36: case 0x37:
-		case 0x38: case 0x39: case 0x3a: case 0x3b: case 0x3c: case 0x3d: case 0x3e: case 0x3f:
-			spu.waveChannel.WriteWaveByte(address - 0xff30, value);
-			return;
-		case 0x40:
-			ppu.WriteLCDC(value);
-			return;
-		case 0x41:
-			ppu.WriteSTAT(value);
-			return;
-		case 0x42:
-			ppu.WriteSCY(value);
-			return;
-		case 0x43:
-			ppu.WriteSCX(value);
-			return;
-		case 0x44:
-			ppu.WriteLY(value);
-			return;
-		case 0x45:
-			ppu.WriteLYC(value);
-			return;
-		case 0x46:
-			dma.WriteOAM(value);
-			return;
-		case 0x47:
-			ppu.WriteBGP(value);
-			return;
-		case 0x48:
-			ppu.WriteOBP0(value);
-			return;
-		case 0x49:
-			ppu.WriteOBP1(value);
-			return;
-		case 0x4a:
-			ppu.WriteWY(value);
-			return;
-		case 0x4b:
-			ppu.WriteWX(value);
-			return;
-		case 0x4d:
-			cpu.key1 = value;
-			return;
-		case 0x4f:
-			mmc->WriteVBK(value);
-			return;
-		case 0x51:
-			dma.WriteHDMA1(value);
-			return;
-		case 0x52:
-			dma.WriteHDMA2(value);
-			return;
-		case 0x53:
-			dma.WriteHDMA3(value);
-			return;
-		case 0x54:
-			dma.WriteHDMA4(value);
-			return;
-		case 0x55:
-			dma.WriteHDMA5(value);
-			return;
-		case 0x56: // Infrared communications port
-			mmc->WriteHRAM(address, value);
-			return;
-		case 0x68:
-			ppu.WriteBGPI(value);
-			return;
-		case 0x69:
-			ppu.WriteBGPD(value);
-			return;
-		case 0x6a:
-			ppu.WriteOBPI(value);
-			return;
-		case 0x6b:
-			ppu.WriteOBPD(value);
-			return;
-		case 0x6c:
-			ppu.WriteOPRI(value);
-			return;
-		case 0x70:
-			mmc->WriteSVBK(value);
-			return;
-		case 0xff:
-			cpu.IE = value;
-			return;
-		default:
-			if ((address & 0xff) >= 0x80) mmc->WriteHRAM(address, value);
-			return;
-		}
+		WriteIO(address, value);
+		return;
 	}
-	std::cout << "Unhandled write to address: 0x" << std::hex << address << "\n";
+	CoreLog() << "Unhandled write to address: 0x" << std::hex << address << "\n";
+}
+
+void Bus::WriteIO(uint16_t address, uint8_t value) {
+	const IORegister& ioRegister = ioRegisters[address & 0x7f];
+#ifdef GBC_IO_STATS
+	ioWrites[address & 0x7f]++;
+#endif
+	if (ioRegister.flags & IORegister::Synchronize) Synchronize();
+	if (ioRegister.flags & IORegister::SynchronizeAudio) spu.Synchronize();
+	ioRegister.write(*this, address, value);
+	if (ioRegister.flags & IORegister::Reschedule) ScheduleEvents();
+}
+
+// Writes to ROM pages usually switch banks instead of changing bytes, so only a
+// changed byte behind the page invalidates its translations.
+void Bus::WriteCode(uint16_t address, uint8_t value) {
+	uint8_t page = address >> 8;
+	const uint8_t* memory = mappedReadPages[page];
+	uint8_t previous = memory ? memory[address & 0xff] : value;
+	WriteMapper(address, value);
+	if (memory && memory[address & 0xff] != previous) {
+		codePages[page] = false;
+		if (!memoryLocked) UpdateWritePage(page);
+		cpu.InvalidateCode(page);
+	}
+}
+
+uint8_t Bus::ReadMapper(uint16_t address) {
+	return std::visit([address](auto& mapper) { return mapper.Read8(address); }, mapper);
+}
+
+void Bus::WriteMapper(uint16_t address, uint8_t value) {
+	std::visit([address, value](auto& mapper) { mapper.Write8(address, value); }, mapper);
 }
 
 uint16_t Bus::Read16(uint16_t address) {
@@ -304,3 +262,120 @@ void Bus::Write16(uint16_t address, uint16_t value) {
 OAMEntry* Bus::GetOAMEntry(uint8_t index) {
 	return mmc->GetOAMEntry(index);
 }
+
+// Unlisted registers read back from the HRAM array and ignore writes. The timer
+// keeps its own time, so its registers neither catch up the bus nor move the
+// other deadlines; writes only reschedule the overflow.
+std::array<IORegister, 0x80> Bus::CreateIORegisters() {
+	const uint8_t Synchronize = IORegister::Synchronize;
+	const uint8_t Reschedule = IORegister::Reschedule;
+	const uint8_t Timed = Synchronize | Reschedule;
+	const uint8_t SynchronizeAudio = IORegister::SynchronizeAudio;
+	std::array<IORegister, 0x80> registers;
+	registers.fill({ nullptr, [](Bus& bus, uint16_t address) { return bus.mmc->ReadHRAM(address); }, [](Bus&, uint16_t, uint8_t) {}, 0 });
+	auto readZero = [](Bus&, uint16_t) -> uint8_t { return 0x00; };
+
+	registers[0x00] = { "P1", [](Bus& bus, uint16_t) { return bus.joypad1.Read(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.joypad1.Write(value); }, 0 };
+	registers[0x01] = { "SB", registers[0x01].read, [](Bus& bus, uint16_t address, uint8_t value) {
+		CoreLog() << "Write to serial: " << std::hex << (int32_t)value << "(" << value << ")" << "\n";
+		bus.mmc->WriteHRAM(address, value);
+	}, 0 };
+	registers[0x02] = { "SC", registers[0x02].read, [](Bus& bus, uint16_t address, uint8_t value) { bus.mmc->WriteHRAM(address, value); }, 0 };
+	registers[0x04] = { "DIV", [](Bus& bus, uint16_t) { return bus.timer.ReadDIV(); }, [](Bus& bus, uint16_t, uint8_t value) {
+		bus.timer.WriteDIV(value);
+		bus.ScheduleEvent(SchedulerEvent::TimerOverflow, bus.timer.CyclesUntilEvent());
+	}, 0 };
+	registers[0x05] = { "TIMA", [](Bus& bus, uint16_t) { return bus.timer.ReadTIMA(); }, [](Bus& bus, uint16_t, uint8_t value) {
+		bus.timer.WriteTIMA(value);
+		bus.ScheduleEvent(SchedulerEvent::TimerOverflow, bus.timer.CyclesUntilEvent());
+	}, 0 };
+	registers[0x06] = { "TMA", [](Bus& bus, uint16_t) { return bus.timer.ReadTMA(); }, [](Bus& bus, uint16_t, uint8_t value) {
+		bus.timer.WriteTMA(value);
+		bus.ScheduleEvent(SchedulerEvent::TimerOverflow, bus.timer.CyclesUntilEvent());
+	}, 0 };
+	registers[0x07] = { "TAC", [](Bus& bus, uint16_t) { return bus.timer.ReadTAC(); }, [](Bus& bus, uint16_t, uint8_t value) {
+		bus.timer.WriteTAC(value);
+		bus.ScheduleEvent(SchedulerEvent::TimerOverflow, bus.timer.CyclesUntilEvent());
+	}, 0 };
+	registers[0x0f] = { "IF", [](Bus& bus, uint16_t) { return bus.cpu.IF; }, [](Bus& bus, uint16_t, uint8_t value) { bus.cpu.IF = value; }, Synchronize };
+
+	static const char* soundNames[] = {
+		"NR10", "NR11", "NR12", "NR13", "NR14", "NR20", "NR21", "NR22", "NR23", "NR24",
+		"NR30", "NR31", "NR32", "NR33", "NR34", "NR40", "NR41", "NR42", "NR43", "NR44",
+	};
+	for (uint32_t i = 0x10; i < 0x24; i++) {
+		registers[i].name = soundNames[i - 0x10];
+		registers[i].flags = SynchronizeAudio;
+	}
+	for (uint32_t i = 0x10; i < 0x15; i++) {
+		registers[i].read = [](Bus& bus, uint16_t address) { return bus.spu.sweepChannel.ReadRegister(address - 0xff10); };
+		registers[i].write = [](Bus& bus, uint16_t address, uint8_t value) { bus.spu.sweepChannel.WriteRegister(address - 0xff10, value); };
+	}
+	for (uint32_t i = 0x15; i < 0x1a; i++) {
+		registers[i].read = [](Bus& bus, uint16_t address) { return bus.spu.toneChannel.ReadRegister(address - 0xff15); };
+		registers[i].write = [](Bus& bus, uint16_t address, uint8_t value) { bus.spu.toneChannel.WriteRegister(address - 0xff15, value); };
+	}
+	for (uint32_t i = 0x1a; i < 0x1f; i++) {
+		registers[i].read = [](Bus& bus, uint16_t address) { return bus.spu.waveChannel.ReadRegister(address - 0xff1a); };
+		registers[i].write = [](Bus& bus, uint16_t address, uint8_t value) { bus.spu.waveChannel.WriteRegister(address - 0xff1a, value); };
+	}
+	for (uint32_t i = 0x1f; i < 0x24; i++) {
+		registers[i].read = [](Bus& bus, uint16_t address) { return bus.spu.noiseChannel.ReadRegister(address - 0xff1f); };
+		registers[i].write = [](Bus& bus, uint16_t address, uint8_t value) { bus.spu.noiseChannel.WriteRegister(address - 0xff1f, value); };
+	}
+	registers[0x24] = { "NR50", [](Bus& bus, uint16_t) { return bus.spu.ReadNR50(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.spu.WriteNR50(value); }, SynchronizeAudio };
+	registers[0x25] = { "NR51", [](Bus& bus, uint16_t) { return bus.spu.ReadNR51(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.spu.WriteNR51(value); }, SynchronizeAudio };
+	registers[0x26] = { "NR52", [](Bus& bus, uint16_t) { return bus.spu.ReadNR52(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.spu.WriteNR52(value); }, SynchronizeAudio };
+	for (uint32_t i = 0x30; i < 0x40; i++) {
+		registers[i] = { "WAVE", [](Bus& bus, uint16_t address) { return bus.spu.waveChannel.ReadWaveByte(address - 0xff30); },
+			[](Bus& bus, uint16_t address, uint8_t value) { bus.spu.waveChannel.WriteWaveByte(address - 0xff30, value); }, SynchronizeAudio };
+	}
+
+	registers[0x40] = { "LCDC", [](Bus& bus, uint16_t) { return bus.ppu.ReadLCDC(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteLCDC(value); }, Timed };
+	registers[0x41] = { "STAT", [](Bus& bus, uint16_t) { return bus.ppu.ReadSTAT(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteSTAT(value); }, Timed };
+	registers[0x42] = { "SCY", [](Bus& bus, uint16_t) { return bus.ppu.ReadSCY(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteSCY(value); }, Timed };
+	registers[0x43] = { "SCX", [](Bus& bus, uint16_t) { return bus.ppu.ReadSCX(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteSCX(value); }, Timed };
+	registers[0x44] = { "LY", [](Bus& bus, uint16_t) { return bus.ppu.ReadLY(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteLY(value); }, Timed };
+	registers[0x45] = { "LYC", [](Bus& bus, uint16_t) { return bus.ppu.ReadLYC(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteLYC(value); }, Timed };
+	registers[0x46] = { "DMA", readZero, [](Bus& bus, uint16_t, uint8_t value) { bus.dma.WriteOAM(value); }, Timed };
+	registers[0x47] = { "BGP", [](Bus& bus, uint16_t) { return bus.ppu.ReadBGP(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteBGP(value); }, Timed };
+	registers[0x48] = { "OBP0", [](Bus& bus, uint16_t) { return bus.ppu.ReadOBP0(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteOBP0(value); }, Timed };
+	registers[0x49] = { "OBP1", [](Bus& bus, uint16_t) { return bus.ppu.ReadOBP1(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteOBP1(value); }, Timed };
+	registers[0x4a] = { "WY", [](Bus& bus, uint16_t) { return bus.ppu.ReadWY(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteWY(value); }, Timed };
+	registers[0x4b] = { "WX", [](Bus& bus, uint16_t) { return bus.ppu.ReadWX(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteWX(value); }, Timed };
+	registers[0x4d] = { "KEY1", [](Bus& bus, uint16_t) { return bus.cpu.key1; }, [](Bus& bus, uint16_t, uint8_t value) { bus.cpu.key1 = value; }, 0 };
+	registers[0x4f] = { "VBK", [](Bus& bus, uint16_t) { return bus.mmc->ReadVBK(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.mmc->WriteVBK(value); }, Synchronize };
+	registers[0x51] = { "HDMA1", readZero, [](Bus& bus, uint16_t, uint8_t value) { bus.dma.WriteHDMA1(value); }, Synchronize };
+	registers[0x52] = { "HDMA2", readZero, [](Bus& bus, uint16_t, uint8_t value) { bus.dma.WriteHDMA2(value); }, Synchronize };
+	registers[0x53] = { "HDMA3", readZero, [](Bus& bus, uint16_t, uint8_t value) { bus.dma.WriteHDMA3(value); }, Synchronize };
+	registers[0x54] = { "HDMA4", readZero, [](Bus& bus, uint16_t, uint8_t value) { bus.dma.WriteHDMA4(value); }, Synchronize };
+	registers[0x55] = { "HDMA5", [](Bus& bus, uint16_t) { return bus.dma.ReadHDMA5(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.dma.WriteHDMA5(value); }, Timed };
+	registers[0x56] = { "RP", [](Bus&, uint16_t) -> uint8_t { return 0xff; }, [](Bus& bus, uint16_t address, uint8_t value) { bus.mmc->WriteHRAM(address, value); }, 0 };
+	registers[0x68] = { "BCPS", [](Bus& bus, uint16_t) { return bus.ppu.ReadBGPI(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteBGPI(value); }, Synchronize };
+	registers[0x69] = { "BCPD", [](Bus& bus, uint16_t) { return bus.ppu.ReadBGPD(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteBGPD(value); }, Synchronize };
+	registers[0x6a] = { "OCPS", [](Bus& bus, uint16_t) { return bus.ppu.ReadOBPI(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteOBPI(value); }, Synchronize };
+	registers[0x6b] = { "OCPD", [](Bus& bus, uint16_t) { return bus.ppu.ReadOBPD(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteOBPD(value); }, Synchronize };
+	registers[0x6c] = { "OPRI", [](Bus& bus, uint16_t) { return bus.ppu.ReadOPRI(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.ppu.WriteOPRI(value); }, Synchronize };
+	registers[0x70] = { "SVBK", [](Bus& bus, uint16_t) { return bus.mmc->ReadSVBK(); }, [](Bus& bus, uint16_t, uint8_t value) { bus.mmc->WriteSVBK(value); }, Synchronize };
+	registers[0x76] = { "PCM12", [](Bus& bus, uint16_t) { return bus.spu.ReadPCM12(); }, registers[0x76].write, SynchronizeAudio };
+	registers[0x77] = { "PCM34", [](Bus& bus, uint16_t) { return bus.spu.ReadPCM34(); }, registers[0x77].write, SynchronizeAudio };
+	return registers;
+}
+
+const std::array<IORegister, 0x80> Bus::ioRegisters = Bus::CreateIORegisters();
+
+#ifdef GBC_IO_STATS
+void Bus::PrintIOStats(std::ostream& out) {
+	out << "register  reads       writes      flags\n";
+	for (uint32_t i = 0; i < 0x80; i++) {
+		if (!ioReads[i] && !ioWrites[i]) continue;
+		const IORegister& ioRegister = ioRegisters[i];
+		out << std::hex << "ff" << std::setw(2) << std::setfill('0') << i << std::dec << std::setfill(' ') << " "
+			<< std::left << std::setw(6) << (ioRegister.name ? ioRegister.name : "-") << std::right
+			<< std::setw(12) << ioReads[i] << std::setw(12) << ioWrites[i] << "  "
+			<< ((ioRegister.flags & IORegister::Synchronize) ? "sync " : "")
+			<< ((ioRegister.flags & IORegister::Reschedule) ? "reschedule " : "")
+			<< ((ioRegister.flags & IORegister::SynchronizeAudio) ? "audio" : "") << "\n";
+	}
+}
+#endif
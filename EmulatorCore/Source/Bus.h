@@ -10,6 +10,7 @@
 #include "DMA.h"
 #include "CPU.h"
 #include "OAMEntry.h"
+#include "Scheduler.h"
 
 class GBCEmulator;
 class MMC;
@@ -28,19 +29,64 @@ enum class Interruption {
 	Joypad = 0b10000
 };
 
+// Handlers and metadata for one register in 0xff00-0xff7f. Registers whose
+// value depends on emulated time catch the components up before the access,
+// and writes that can move an event deadline reschedule afterwards. Sound
+// registers only catch up the SPU, nothing else depends on it.
+struct IORegister {
+	static const uint8_t Synchronize = 0b1;
+	static const uint8_t Reschedule = 0b10;
+	static const uint8_t SynchronizeAudio = 0b100;
+
+	const char* name;
+	uint8_t(*read)(Bus& bus, uint16_t address);
+	void(*write)(Bus& bus, uint16_t address, uint8_t value);
+	uint8_t flags;
+};
+
 class Bus {
 public:
-	Bus(MMC* mmc, DMA& dma, Joypad& jooypad1, Timer& timer, SPU& spu, PPU& ppu, CPU& cpu);
+	Bus(Scheduler& scheduler, Mapper& mapper, DMA& dma, Joypad& jooypad1, Timer& timer, SPU& spu, PPU& ppu, CPU& cpu);
 
 	void Reset();
 	void TriggerInterruption(Interruption exception);
+	void Synchronize();
+	void ScheduleEvents();
 
-	uint8_t Read8(uint16_t address, bool isDMAAccess = false);
-	void Write8(uint16_t address, uint8_t value, bool isDMAAccess = false);
+	void MapPages(uint16_t address, uint32_t size, const uint8_t* readMemory, uint8_t* writeMemory);
+	void LockMemoryMap();
+	void UnlockMemoryMap();
+	void WatchCodePage(uint8_t page);
+	void WriteVRAMBlock(uint16_t address, const uint8_t* data, uint32_t size);
+	void ClearCodePages();
+	const uint8_t* GetReadPage(uint8_t page) { return readPages[page]; }
+	// The page as mapped, including while the map is locked by OAM DMA.
+	const uint8_t* GetMappedReadPage(uint8_t page) { return mappedReadPages[page]; }
+
+	uint8_t Read8(uint16_t address, bool isDMAAccess = false) {
+		const uint8_t* page = readPages[address >> 8];
+		if (page) return page[address & 0xff];
+		return ReadSlow(address, isDMAAccess);
+	}
+	void Write8(uint16_t address, uint8_t value, bool isDMAAccess = false) {
+		uint8_t* page = writePages[address >> 8];
+		if (page) {
+			page[address & 0xff] = value;
+			return;
+		}
+		WriteSlow(address, value, isDMAAccess);
+	}
 	uint16_t Read16(uint16_t address);
 	void Write16(uint16_t address, uint16_t value);
 	OAMEntry* GetOAMEntry(uint8_t index);
+	static const IORegister& GetIORegister(uint8_t index) { return ioRegisters[index & 0x7f]; }
+#ifdef GBC_IO_STATS
+	void PrintIOStats(std::ostream& out);
+#endif
 
+	Scheduler& scheduler;
+	Mapper& mapper;
+	// Memory shared by all mapper types, inside the active mapper.
 	MMC* mmc;
 	DMA& dma;
 	Joypad& joypad1;
@@ -50,6 +96,36 @@ public:
 	CPU& cpu;
 
 private:
+	// Host pointers for every 256 byte page. Null pages go through the slow handlers:
+	// I/O, OAM, VRAM writes, disabled cartridge RAM and the whole map while OAM DMA runs.
+	std::array<const uint8_t*, 0x100> readPages;
+	std::array<uint8_t*, 0x100> writePages;
+	std::array<const uint8_t*, 0x100> mappedReadPages;
+	std::array<uint8_t*, 0x100> mappedWritePages;
+	// Pages holding translated or decoded code. Their writes take the slow path so stale code can be dropped.
+	std::array<bool, 0x100> codePages;
+	bool memoryLocked = false;
+	static const std::array<IORegister, 0x80> ioRegisters;
+#ifdef GBC_IO_STATS
+	std::array<uint64_t, 0x80> ioReads = {};
+	std::array<uint64_t, 0x80> ioWrites = {};
+#endif
+
+	uint8_t ReadSlow(uint16_t address, bool isDMAAccess);
+	void WriteSlow(uint16_t address, uint8_t value, bool isDMAAccess);
+	uint8_t ReadIO(uint16_t address);
+	void WriteIO(uint16_t address, uint8_t value);
+	void WriteCode(uint16_t address, uint8_t value);
+	uint8_t ReadMapper(uint16_t address);
+	void WriteMapper(uint16_t address, uint8_t value);
+	void UpdateWritePage(uint32_t page);
+	template <typename T>
+	static void FillPages(T** pages, uint32_t count, T* memory);
+	void ScheduleEvent(SchedulerEvent event, uint32_t cycles);
+	static std::array<IORegister, 0x80> CreateIORegisters();
+
 	friend class GBCEmulator;
+	friend class JIT;
+	friend class InstructionCache;
 };
 
@@ -1,8 +1,10 @@
 #include "CPU.h"
+#include "Log.h"
 
-CPU::CPU(Bus& bus) : bus(bus) {}
+CPU::CPU(Bus& bus) : bus(bus), jit(*this, bus), instructionCache(*this, bus) {}
 
 void CPU::Reset() {
+	ResolveFlags();
 	AF = 0x01b0;
 	BC = 0x0013;
 	DE = 0x00d8;
@@ -15,13 +17,16 @@ void CPU::Reset() {
 	key1 = 0x0;
 	isHalting = false;
 	haltBug = false;
+	idleLoopSkips = 0;
+	idleCyclesSkipped = 0;
+	FlushCode();
 }
 
 uint32_t CPU::Step() {
 	if (HandleInterruptions()) return 20;
 	if (isHalting) return 4;
 	opcode = Read8(PC);
-	if(logAssembler) std::cout << std::hex << "0x" << PC << ": " << baseOpcodeTable[opcode].assembler << " BC=" << BC << " DE=" << DE << " HL=" << HL << " AF=" << AF << " SP=" << SP << "\n";
+	if(logAssembler) CoreLog() << std::hex << "0x" << PC << ": " << baseOpcodeTable[opcode].assembler << " BC=" << BC << " DE=" << DE << " HL=" << HL << " AF=" << AF << " SP=" << SP << "\n";
 
 	if (!haltBug) PC++;
 	haltBug = false;
@@ -43,2702 +48,623 @@ uint32_t CPU::Step() {
 	uint32_t cpuCycles = stepClock;
 	clock += stepClock;
 	stepClock = 0;
+	instructions++;
 	return cpuCycles;
 }
 
-bool CPU::HandleInterruptions() {
-	uint8_t interruptions = IF & IE & 0x1f;
-	if (!interruptions) return false;
-	isHalting = false;
-	if (!IME) return false;
-
-	if (interruptions & (uint8_t)Interruption::VBlank) {
-		IF &= ~(uint8_t)Interruption::VBlank;
-		HandleInterruption(0x40);
-	}
-	else if (interruptions & (uint8_t)Interruption::LCD) {
-		IF &= ~(uint8_t)Interruption::LCD;
-		HandleInterruption(0x48);
-	}
-	else if (interruptions & (uint8_t)Interruption::Timer) {
-		IF &= ~(uint8_t)Interruption::Timer;
-		HandleInterruption(0x50);
-	}
-	else if (interruptions & (uint8_t)Interruption::Serial) {
-		IF &= ~(uint8_t)Interruption::Serial;
-		HandleInterruption(0x58);
-	}
-	else if (interruptions & (uint8_t)Interruption::Joypad) {
-		IF &= ~(uint8_t)Interruption::Joypad;
-		HandleInterruption(0x60);
-	}
-
-	return true;
-}
-
-void CPU::HandleInterruption(uint16_t handlerAddress) {
-	IME = 0;
-	Push16(PC);
-	PC = handlerAddress;
-}
-
-// Help Instructions
-uint8_t CPU::GetR8(uint8_t index) {
-	switch (index & 0b111) {
-	case 0:
-		return B;
-	case 1:
-		return C;
-	case 2:
-		return D;
-	case 3:
-		return E;
-	case 4:
-		return H;
-	case 5:
-		return L;
-	case 6:
-		std::cout << "Error: Read from register at index 6 should be using [HL] instructions.\n";
-		return 0;
-	case 7:
-		return A;
-	}
-	return 0;
-}
-
-void CPU::SetR8(uint8_t index, uint8_t value) {
-	switch (index & 0b111) {
-	case 0:
-		B = value;
-		break;
-	case 1:
-		C = value;
-		break;
-	case 2:
-		D = value;
-		break;
-	case 3:
-		E = value;
-		break;
-	case 4:
-		H = value;
-		break;
-	case 5:
-		L = value;
-		break;
-	case 6:
-		std::cout << "Error: Write to register at index 6 should be using [HL] instructions.\n";
-		break;
-	case 7:
-		A = value;
-		break;
-	}
-}
-
-uint16_t CPU::GetR16(uint8_t index) {
-	switch (index & 0b11) {
-	case 0:
-		return BC;
-	case 1:
-		return DE;
-	case 2:
-		return HL;
-	case 3:
-		if (opcode >> 7) {
-			return AF;
-		}
-		else {
-			return SP;
-		}
-	}
-	return 0;
-}
-
-void CPU::SetR16(uint8_t index, uint16_t value) {
-	switch (index & 0b11) {
-	case 0:
-		BC = value;
-		break;
-	case 1:
-		DE = value;
-		break;
-	case 2:
-		HL = value;
-		break;
-	case 3:
-		if (opcode >> 7) {
-			AF = value & 0xfff0;
-		}
-		else {
-			SP = value;
-		}
-		break;
-	}
-}
-
-uint8_t CPU::Read8(uint16_t address) {
-	return bus.Read8(address);
-}
-
-void CPU::Write8(uint16_t address, uint8_t value) {
-	bus.Write8(address, value);
-}
-
-uint16_t CPU::Read16(uint16_t address) {
-	return bus.Read16(address);
-}
-
-void CPU::Write16(uint16_t address, uint16_t value) {
-	bus.Write16(address, value);
-}
-
-uint16_t CPU::Pop16() {
-	SP += 2;
-	return bus.Read16(SP - 2);
-}
-
-void CPU::Push16(uint16_t value) {
-	SP -= 2;
-	bus.Write16(SP, value);
-}
-
-void CPU::WriteState(SaveState& state) {
-	state.Write16(AF);
-	state.Write16(BC);
-	state.Write16(DE);
-	state.Write16(HL);
-	state.Write16(SP);
-	state.Write8(IF);
-	state.Write8(IE);
-	state.Write8(IME);
-	state.Write8(isHalting);
-	state.Write8(haltBug);
-	state.Write8(key1);
-}
-
-void CPU::LoadState(SaveState& state) {
-	AF = state.Read16();
-	BC = state.Read16();
-	DE = state.Read16();
-	HL = state.Read16();
-	SP = state.Read16();
-	IF = state.Read8();
-	IE = state.Read8();
-	IME = state.Read8();
-	isHalting = state.Read8();
-	haltBug = state.Read8();
-	key1 = state.Read8();
-}
-
-bool CPU::CheckCondition(uint8_t condition) {
-	switch (condition & 0b11) {
-	case 0:
-		return !fZero;
-	case 1:
-		return fZero;
-	case 2:
-		return !fCarry;
-	case 3:
-		return fCarry;
-	}
-	return false;
-}
-
-void CPU::ExecuteThroughTable() {
-	(this->*baseOpcodeTable[opcode].inst)();
-}
-
-void CPU::ExecuteInline() {
-	uint32_t result, temp;
-	
-	switch (opcode) {
-	case 0x00:
-		break;
-	case 0x01:
-		BC = attr16;
-		break;
-	case 0x02:
-		Write8(BC, A);
-		break;
-	case 0x03:
-		BC++;
-		break;
-	case 0x04:
-		fSub = 0;
-		fHalfCarry = (B & 0xf) == 0xf;
-		B++;
-		fZero = (B == 0);
-		break;
-	case 0x05:
-		fSub = 1;
-		fHalfCarry = (B & 0xf) == 0;
-		B--;
-		fZero = (B == 0);
-		break;
-	case 0x06:
-		B = attr8;
-		break;
-	case 0x07:
-		A = (A << 1) | (A >> 7);
-		fZero = 0;
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = A & 1;
-		break;
-	case 0x08:
-		Write16(attr16, SP);
-		break;
-	case 0x09:
-		result = HL + BC;
-		fSub = 0;
-		fHalfCarry = ((HL & 0x0fff) + (BC & 0x0fff)) > 0x0fff;
-		fCarry = result > 0xffff;
-		HL = result;
-		break;
-	case 0x0a:
-		A = Read8(BC);
-		break;
-	case 0x0b:
-		BC--;
-		break;
-	case 0x0c:
-		fSub = 0;
-		fHalfCarry = (C & 0xf) == 0xf;
-		C++;
-		fZero = (C == 0);
-		break;
-	case 0x0d:
-		fSub = 1;
-		fHalfCarry = (C & 0xf) == 0;
-		C--;
-		fZero = (C == 0);
-		break;
-	case 0x0e:
-		C = attr8;
-		break;
-	case 0x0f:
-		A = (A >> 1) | (A << 7);
-		fCarry = A >> 7;
-		fZero = 0;
-		fSub = 0;
-		fHalfCarry = 0;
-		break;
-	case 0x10:
-		Write8(0xff04, 0);
-		break;
-	case 0x11:
-		DE = attr16;
-		break;
-	case 0x12:
-		Write8(DE, A);
-		break;
-	case 0x13:
-		DE++;
-		break;
-	case 0x14:
-		fSub = 0;
-		fHalfCarry = (D & 0xf) == 0xf;
-		D++;
-		fZero = (D == 0);
-		break;
-	case 0x15:
-		fSub = 1;
-		fHalfCarry = (D & 0xf) == 0;
-		D--;
-		fZero = (D == 0);
-		break;
-	case 0x16:
-		D = attr8;
-		break;
-	case 0x017:
-		temp = A >> 7;
-		A = (A << 1) | fCarry;
-		fZero = 0;
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = temp;
-		break;
-	case 0x18:
-		PC += (int8_t)attr8;
-		break;
-	case 0x19:
-		result = HL + DE;
-		fSub = 0;
-		fHalfCarry = ((HL & 0x0fff) + (DE & 0x0fff)) > 0x0fff;
-		fCarry = result > 0xffff;
-		HL = result;
-		break;
-	case 0x1a:
-		A = Read8(DE);
-		break;
-	case 0x1b:
-		DE--;
-		break;
-	case 0x1c:
-		fSub = 0;
-		fHalfCarry = (E & 0xf) == 0xf;
-		E++;
-		fZero = (E == 0);
-		break;
-	case 0x1d:
-		fSub = 1;
-		fHalfCarry = (E & 0xf) == 0;
-		E--;
-		fZero = (E == 0);
-		break;
-	case 0x1e:
-		E = attr8;
-		break;
-	case 0x1f:
-		temp = A & 0b1;
-		A = (A >> 1) | (fCarry << 7);
-		fZero = 0;
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = temp;
-		break;
-	case 0x20:
-		if (!fZero) {
-			PC += (int8_t)attr8;
-			stepClock += 4;
-		}
-		break;
-	case 0x21:
-		HL = attr16;
-		break;
-	case 0x22:
-		Write8(HL, A);
-		HL++;
-		break;
-	case 0x23:
-		HL++;
-		break;
-	case 0x24:
-		fSub = 0;
-		fHalfCarry = (H & 0xf) == 0xf;
-		H++;
-		fZero = (H == 0);
-		break;
-	case 0x25:
-		fSub = 1;
-		fHalfCarry = (H & 0xf) == 0;
-		H--;
-		fZero = (H == 0);
-		break;
-	case 0x26:
-		H = attr8;
-		break;
-	case 0x27:
-		if (!fSub) {
-			if (fCarry || A > 0x99) { A += 0x60; fCarry = 1; }
-			if (fHalfCarry || (A & 0x0f) > 0x09) { A += 0x6; }
-		}
-		else {
-			if (fCarry) { A -= 0x60; }
-			if (fHalfCarry) { A -= 0x6; }
-		}
-		fZero = (A == 0);
-		fHalfCarry = 0;
-		break;
-	case 0x28:
-		if (fZero) {
-			PC += (int8_t)attr8;
-			stepClock += 4;
-		}
-		break;
-	case 0x29:
-		result = HL + HL;
-		fSub = 0;
-		fHalfCarry = ((HL & 0x0fff) + (HL & 0x0fff)) > 0x0fff;
-		fCarry = result > 0xffff;
-		HL = result;
-		break;
-	case 0x2a:
-		A = Read8(HL);
-		HL++;
-		break;
-	case 0x2b:
-		HL--;
-		break;
-	case 0x2c:
-		fSub = 0;
-		fHalfCarry = (L & 0xf) == 0xf;
-		L++;
-		fZero = (L == 0);
-		break;
-	case 0x2d:
-		fSub = 1;
-		fHalfCarry = (L & 0xf) == 0;
-		L--;
-		fZero = (L == 0);
-		break;
-	case 0x2e:
-		L = attr8;
-		break;
-	case 0x2f:
-		A = ~A;
-		fSub = 1;
-		fHalfCarry = 1;
-		break;
-	case 0x30:
-		if (!fCarry) {
-			PC += (int8_t)attr8;
-			stepClock += 4;
-		}
-		break;
-	case 0x31:
-		SP = attr16;
-		break;
-	case 0x32:
-		Write8(HL, A);
-		HL--;
-		break;
-	case 0x33:
-		SP++;
-		break;
-	case 0x34:
-		temp = Read8(HL);
-		result = (temp + 1) & 0xff;
-		Write8(HL, result);
-		fZero = (result == 0);
-		fSub = 0;
-		fHalfCarry = (temp & 0xf) == 0xf;
-		break;
-	case 0x35:
-		temp = Read8(HL);
-		result = (temp - 1) & 0xff;
-		Write8(HL, result);
-		fZero = (result == 0);
-		fSub = 1;
-		fHalfCarry = (temp & 0xf) == 0;
-		break;
-	case 0x36:
-		Write8(HL, attr8);
-		break;
-	case 0x37:
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 1;
-		break;
-	case 0x38:
-		if (fCarry) {
-			PC += (int8_t)attr8;
-			stepClock += 4;
-		}
-		break;
-	case 0x39:
-		result = HL + SP;
-		fSub = 0;
-		fHalfCarry = ((HL & 0x0fff) + (SP & 0x0fff)) > 0x0fff;
-		fCarry = result > 0xffff;
-		HL = result;
-		break;
-	case 0x3a:
-		A = Read8(HL);
-		HL--;
-		break;
-	case 0x3b:
-		SP--;
-		break;
-	case 0x3c:
-		fSub = 0;
-		fHalfCarry = (A & 0xf) == 0xf;
-		A++;
-		fZero = (A == 0);
-		break;
-	case 0x3d:
-		fSub = 1;
-		fHalfCarry = (A & 0xf) == 0;
-		A--;
-		fZero = (A == 0);
-		break;
-	case 0x3e:
-		A = attr8;
-		break;
-	case 0x3f:
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = !fCarry;
-		break;
-	case 0x40:
-		break;
-	case 0x41:
-		B = C;
-		break;
-	case 0x42:
-		B = D;
-		break;
-	case 0x43:
-		B = E;
-		break;
-	case 0x44:
-		B = H;
-		break;
-	case 0x45:
-		B = L;
-		break;
-	case 0x46:
-		B = Read8(HL);
-		break;
-	case 0x47:
-		B = A;
-		break;
-	case 0x48:
-		C = B;
-		break;
-	case 0x49:
-		break;
-	case 0x4a:
-		C = D;
-		break;
-	case 0x4b:
-		C = E;
-		break;
-	case 0x4c:
-		C = H;
-		break;
-	case 0x4d:
-		C = L;
-		break;
-	case 0x4e:
-		C = Read8(HL);
-		break;
-	case 0x4f:
-		C = A;
-		break;
-	case 0x50:
-		D = B;
-		break;
-	case 0x51:
-		D = C;
-		break;
-	case 0x52:
-		break;
-	case 0x53:
-		D = E;
-		break;
-	case 0x54:
-		D = H;
-		break;
-	case 0x55:
-		D = L;
-		break;
-	case 0x56:
-		D = Read8(HL);
-		break;
-	case 0x57:
-		D = A;
-		break;
-	case 0x58:
-		E = B;
-		break;
-	case 0x59:
-		E = C;
-		break;
-	case 0x5a:
-		E = D;
-		break;
-	case 0x5b:
-		break;
-	case 0x5c:
-		E = H;
-		break;
-	case 0x5d:
-		E = L;
-		break;
-	case 0x5e:
-		E = Read8(HL);
-		break;
-	case 0x5f:
-		E = A;
-		break;
-	case 0x60:
-		H = B;
-		break;
-	case 0x61:
-		H = C;
-		break;
-	case 0x62:
-		H = D;
-		break;
-	case 0x63:
-		H = E;
-		break;
-	case 0x64:
-		break;
-	case 0x65:
-		H = L;
-		break;
-	case 0x66:
-		H = Read8(HL);
-		break;
-	case 0x67:
-		H = A;
-		break;
-	case 0x68:
-		L = B;
-		break;
-	case 0x69:
-		L = C;
-		break;
-	case 0x6a:
-		L = D;
-		break;
-	case 0x6b:
-		L = E;
-		break;
-	case 0x6c:
-		L = H;
-		break;
-	case 0x6d:
-		break;
-	case 0x6e:
-		L = Read8(HL);
-		break;
-	case 0x6f:
-		L = A;
-		break;
-	case 0x70:
-		Write8(HL, B);
-		break;
-	case 0x71:
-		Write8(HL, C);
-		break;
-	case 0x72:
-		Write8(HL, D);
-		break;
-	case 0x73:
-		Write8(HL, E);
-		break;
-	case 0x74:
-		Write8(HL, H);
-		break;
-	case 0x75:
-		Write8(HL, L);
-		break;
-	case 0x76:
-		if (IME || (IE & IF & 0x1f) == 0) {
-			isHalting = true;
-		}
-		else {
-			haltBug = true;
-		}
-		stepClock += 4;
-		break;
-	case 0x77:
-		Write8(HL, A);
-		break;
-	case 0x78:
-		A = B;
-		break;
-	case 0x79:
-		A = C;
-		break;
-	case 0x7a:
-		A = D;
-		break;
-	case 0x7b:
-		A = E;
-		break;
-	case 0x7c:
-		A = H;
-		break;
-	case 0x7d:
-		A = L;
-		break;
-	case 0x7e:
-		A = Read8(HL);
-		break;
-	case 0x7f:
-		break;
-	case 0x80:
-		result = A + B;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (B & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x81:
-		result = A + C;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (C & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x82:
-		result = A + D;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (D & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x83:
-		result = A + E;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (E & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x84:
-		result = A + H;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (H & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x85:
-		result = A + L;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (L & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x86:
-		temp = Read8(HL);
-		result = A + temp;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (temp & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x87:
-		result = A + A;
-		fZero = ((result & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (A & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		break;
-	case 0x88:
-		result = A + B + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (B & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x89:
-		result = A + C + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (C & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x8a:
-		result = A + D + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (D & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x8b:
-		result = A + E + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (E & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x8c:
-		result = A + H + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (H & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x8d:
-		result = A + L + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (L & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x8e:
-		temp = Read8(HL);
-		result = A + temp + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (temp & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x8f:
-		result = A + A + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (A & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x90:
-		result = A - B;
-		fSub = 1;
-		fHalfCarry = (B & 0x0f) > (A & 0x0f);
-		fCarry = B > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x91:
-		result = A - C;
-		fSub = 1;
-		fHalfCarry = (C & 0x0f) > (A & 0x0f);
-		fCarry = C > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x92:
-		result = A - D;
-		fSub = 1;
-		fHalfCarry = (D & 0x0f) > (A & 0x0f);
-		fCarry = D > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x93:
-		result = A - E;
-		fSub = 1;
-		fHalfCarry = (E & 0x0f) > (A & 0x0f);
-		fCarry = E > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x94:
-		result = A - H;
-		fSub = 1;
-		fHalfCarry = (H & 0x0f) > (A & 0x0f);
-		fCarry = H > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x95:
-		result = A - L;
-		fSub = 1;
-		fHalfCarry = (L & 0x0f) > (A & 0x0f);
-		fCarry = L > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x96:
-		temp = Read8(HL);
-		result = A - temp;
-		fSub = 1;
-		fHalfCarry = ((uint8_t)temp & 0x0f) > (A & 0x0f);
-		fCarry = temp > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x97:
-		A = 0;
-		fSub = 1;
-		fCarry = 0;
-		fHalfCarry = 0;
-		fZero = 1;
-		break;
-	case 0x98:
-		result = A - B - fCarry;
-		fSub = 1;
-		fHalfCarry = ((B & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x99:
-		result = A - C - fCarry;
-		fSub = 1;
-		fHalfCarry = ((C & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x9a:
-		result = A - D - fCarry;
-		fSub = 1;
-		fHalfCarry = ((D & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x9b:
-		result = A - E - fCarry;
-		fSub = 1;
-		fHalfCarry = ((E & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x9c:
-		result = A - H - fCarry;
-		fSub = 1;
-		fHalfCarry = ((H & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x9d:
-		result = A - L - fCarry;
-		fSub = 1;
-		fHalfCarry = ((L & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x9e:
-		temp = Read8(HL);
-		result = A - temp - fCarry;
-		fSub = 1;
-		fHalfCarry = ((uint8_t)(temp & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0x9f:
-		result = A - A - fCarry;
-		fSub = 1;
-		fHalfCarry = ((A & 0x0f) + fCarry) > (A & 0x0f);
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0xa0:
-		A &= B;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa1:
-		A &= C;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa2:
-		A &= D;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa3:
-		A &= E;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa4:
-		A &= H;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa5:
-		A &= L;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa6:
-		A &= Read8(HL);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa7:
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xa8:
-		A ^= B;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xa9:
-		A ^= C;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xaa:
-		A ^= D;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xab:
-		A ^= E;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xac:
-		A ^= H;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xad:
-		A ^= L;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xae:
-		A ^= Read8(HL);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xaf:
-		A = 0;
-		fZero = 1;
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb0:
-		A |= B;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb1:
-		A |= C;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb2:
-		A |= D;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb3:
-		A |= E;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb4:
-		A |= H;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb5:
-		A |= L;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb6:
-		A |= Read8(HL);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb7:
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xb8:
-		fZero = (B == A);
-		fSub = 1;
-		fHalfCarry = (B & 0x0f) > (A & 0x0f);
-		fCarry = B > A;
-		break;
-	case 0xb9:
-		fZero = (C == A);
-		fSub = 1;
-		fHalfCarry = (C & 0x0f) > (A & 0x0f);
-		fCarry = C > A;
-		break;
-	case 0xba:
-		fZero = (D == A);
-		fSub = 1;
-		fHalfCarry = (D & 0x0f) > (A & 0x0f);
-		fCarry = D > A;
-		break;
-	case 0xbb:
-		fZero = (E == A);
-		fSub = 1;
-		fHalfCarry = (E & 0x0f) > (A & 0x0f);
-		fCarry = E > A;
-		break;
-	case 0xbc:
-		fZero = (H == A);
-		fSub = 1;
-		fHalfCarry = (H & 0x0f) > (A & 0x0f);
-		fCarry = H > A;
-		break;
-	case 0xbd:
-		fZero = (L == A);
-		fSub = 1;
-		fHalfCarry = (L & 0x0f) > (A & 0x0f);
-		fCarry = L > A;
-		break;
-	case 0xbe:
-		temp = Read8(HL);
-		fZero = (temp == A);
-		fSub = 1;
-		fHalfCarry = ((uint8_t)temp & 0x0f) > (A & 0x0f);
-		fCarry = temp > A;
-		break;
-	case 0xbf:
-		fZero = 1;
-		fSub = 1;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xc0:
-		if (!fZero) {
-			PC = Pop16();
-			stepClock += 12;
-		}
-		break;
-	case 0xc1:
-		BC = Pop16();
-		break;
-	case 0xc2:
-		if (!fZero) {
-			PC = attr16;
-			stepClock += 4;
-		}
-		break;
-	case 0xc3:
-		PC = attr16;
-		break;
-	case 0xc4:
-		if (!fZero) {
-			Push16(PC);
-			PC = attr16;
-			stepClock += 12;
-		}
-		break;
-	case 0xc5:
-		Push16(BC);
-		break;
-	case 0xc6:
-		result = A + attr8;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0f) + (attr8 & 0x0f)) > 0x0f;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0xc7:
-		Push16(PC);
-		PC = 0x00;
-		break;
-	case 0xc8:
-		if (fZero) {
-			PC = Pop16();
-			stepClock += 12;
-		}
-		break;
-	case 0xc9:
-		PC = Pop16();
-		break;
-	case 0xca:
-		if (fZero) {
-			PC = attr16;
-			stepClock += 4;
-		}
-		break;
-	case 0xcb:
-		secondaryOpcode = Read8(PC);
-		PC++;
-		stepClock += prefixOpcodeTimingTable[secondaryOpcode] * 4;
-		ExecutePrefixInline();
-		break;
-	case 0xcc:
-		if (fZero) {
-			Push16(PC);
-			PC = attr16;
-			stepClock += 12;
-		}
-		break;
-	case 0xcd:
-		Push16(PC);
-		PC = attr16;
-		break;
-	case 0xce:
-		result = A + attr8 + fCarry;
-		fSub = 0;
-		fHalfCarry = ((A & 0x0F) + (attr8 & 0x0f) + fCarry) > 0x0F;
-		fCarry = result > 0xff;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0xcf:
-		Push16(PC);
-		PC = 0x08;
-		break;
-	case 0xd0:
-		if (!fCarry) {
-			PC = Pop16();
-			stepClock += 12;
-		}
-		break;
-	case 0xd1:
-		DE = Pop16();
-		break;
-	case 0xd2:
-		if (!fCarry) {
-			PC = attr16;
-			stepClock += 4;
-		}
-		break;
-	case 0xd4:
-		if (!fCarry) {
-			Push16(PC);
-			PC = attr16;
-			stepClock += 12;
-		}
-		break;
-	case 0xd5:
-		Push16(DE);
-		break;
-	case 0xd6:
-		result = A - attr8;
-		fSub = 1;
-		fHalfCarry = (attr8 & 0x0f) > (A & 0x0f);
-		fCarry = attr8 > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0xd7:
-		Push16(PC);
-		PC = 0x10;
-		break;
-	case 0xd8:
-		if (fCarry) {
-			PC = Pop16();
-			stepClock += 12;
-		}
-		break;
-	case 0xd9:
-		PC = Pop16();
-		IME = 1;
-		break;
-	case 0xda:
-		if (fCarry) {
-			PC = attr16;
-			stepClock += 4;
-		}
-		break;
-	case 0xdc:
-		if (fCarry) {
-			Push16(PC);
-			PC = attr16;
-			stepClock += 12;
-		}
-		break;
-	case 0xde:
-		result = A - attr8 - fCarry;
-		fSub = 1;
-		fHalfCarry = ((attr8 & 0x0f) + fCarry) > (A & 0x0f);
-		fCarry = (attr8 + fCarry) > A;
-		A = result;
-		fZero = (A == 0);
-		break;
-	case 0xdf:
-		Push16(PC);
-		PC = 0x18;
-		break;
-	case 0xe0:
-		Write8(0xff00 | attr8, A);
-		break;
-	case 0xe1:
-		HL = Pop16();
-		break;
-	case 0xe2:
-		Write8(0xff00 | C, A);
-		break;
-	case 0xe5:
-		Push16(HL);
-		break;
-	case 0xe6:
-		A &= attr8;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 1;
-		fCarry = 0;
-		break;
-	case 0xe7:
-		Push16(PC);
-		PC = 0x20;
-		break;
-	case 0xe8:
-		result = SP + (int8_t)attr8;
-		fHalfCarry = ((SP ^ attr8 ^ result) & 0x10) == 0x10;
-		fCarry = ((SP ^ (int16_t)((int8_t)attr8) ^ result) & 0x100) == 0x100;
-		fZero = 0;
-		fSub = 0;
-		SP = result;
-		break;
-	case 0xe9:
-		PC = HL;
-		break;
-	case 0xea:
-		Write8(attr16, A);
-		break;
-	case 0xee:
-		A ^= attr8;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xef:
-		Push16(PC);
-		PC = 0x28;
-		break;
-	case 0xf0:
-		A = Read8(0xff00 | attr8);
-		break;
-	case 0xf1:
-		AF = Pop16() & 0xfff0;
-		break;
-	case 0xf2:
-		A = Read8(0xff00 | C);
-		break;
-	case 0xf3:
-		IME = 0;
-		break;
-	case 0xf5:
-		Push16(AF & 0xfff0);
-		break;
-	case 0xf6:
-		A |= attr8;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0xf7:
-		Push16(PC);
-		PC = 0x30;
-		break;
-	case 0xf8:
-		result = SP + (int8_t)attr8;
-		fZero = 0;
-		fSub = 0;
-		fHalfCarry = ((SP ^ attr8 ^ result) & 0x10) == 0x10;
-		fCarry = ((SP ^ (int16_t)((int8_t)attr8) ^ result) & 0x100) == 0x100;
-		HL = result;
-		break;
-	case 0xf9:
-		SP = HL;
-		break;
-	case 0xfa:
-		A = Read8(attr16);
-		break;
-	case 0xfb:
-		//stepClock += Step();
-		//if (opcode != 0xf3) {
-			IME = 1;
-		//}
-		break;
-	case 0xfe:
-		fZero = (A == attr8);
-		fSub = 1;
-		fHalfCarry = (attr8 & 0x0f) > (A & 0x0f);
-		fCarry = attr8 > A;
-		break;
-	case 0xff:
-		Push16(PC);
-		PC = 0x38;
-		break;
-	default:
-		std::cout << "Unhandled instruction: 0x" << std::hex << (uint32_t)opcode << "\n";
-		ExecuteThroughTable();
-	}
-}
-
-void CPU::ExecutePrefixThroughTable() {
-	(this->*prefixOpcodeTable[secondaryOpcode].inst)();
-}
-
-void CPU::ExecutePrefixInline() {
-	uint8_t carry, sign;
-	uint32_t temp;
-	switch (secondaryOpcode) {
-	case 0x00:
-		carry = B >> 7;
-		B = (B << 1) | carry;
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x01:
-		carry = C >> 7;
-		C = (C << 1) | carry;
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x02:
-		carry = D >> 7;
-		D = (D << 1) | carry;
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x03:
-		carry = E >> 7;
-		E = (E << 1) | carry;
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x04:
-		carry = H >> 7;
-		H = (H << 1) | carry;
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x05:
-		carry = L >> 7;
-		L = (L << 1) | carry;
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x06:
-		temp = Read8(HL);
-		carry = temp >> 7;
-		temp = (temp << 1) | carry;
-		Write8(HL, temp);
-		fZero = (temp == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x07:
-		carry = A >> 7;
-		A = (A << 1) | carry;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x08:
-		carry = B & 0b1;
-		B = (B >> 1) | (carry << 7);
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x09:
-		carry = C & 0b1;
-		C = (C >> 1) | (carry << 7);
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x0a:
-		carry = D & 0b1;
-		D = (D >> 1) | (carry << 7);
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x0b:
-		carry = E & 0b1;
-		E = (E >> 1) | (carry << 7);
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x0c:
-		carry = H & 0b1;
-		H = (H >> 1) | (carry << 7);
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x0d:
-		carry = L & 0b1;
-		L = (L >> 1) | (carry << 7);
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x0e:
-		temp = Read8(HL);
-		carry = temp & 0b1;
-		temp = (temp >> 1) | (carry << 7);
-		Write8(HL, temp);
-		fZero = (temp == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x0f:
-		carry = A & 0b1;
-		A = (A >> 1) | (carry << 7);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x10:
-		carry = B >> 7;
-		B = (B << 1) | fCarry;
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x11:
-		carry = C >> 7;
-		C = (C << 1) | fCarry;
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x12:
-		carry = D >> 7;
-		D = (D << 1) | fCarry;
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x13:
-		carry = E >> 7;
-		E = (E << 1) | fCarry;
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x14:
-		carry = H >> 7;
-		H = (H << 1) | fCarry;
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x15:
-		carry = L >> 7;
-		L = (L << 1) | fCarry;
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x16:
-		temp = Read8(HL);
-		carry = temp >> 7;
-		temp = (temp << 1) | fCarry;
-		Write8(HL, temp);
-		fZero = ((temp & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x17:
-		carry = A >> 7;
-		A = (A << 1) | fCarry;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x18:
-		carry = B & 0b1;
-		B = (B >> 1) | (fCarry << 7);
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x19:
-		carry = C & 0b1;
-		C = (C >> 1) | (fCarry << 7);
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x1a:
-		carry = D & 0b1;
-		D = (D >> 1) | (fCarry << 7);
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x1b:
-		carry = E & 0b1;
-		E = (E >> 1) | (fCarry << 7);
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x1c:
-		carry = H & 0b1;
-		H = (H >> 1) | (fCarry << 7);
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x1d:
-		carry = L & 0b1;
-		L = (L >> 1) | (fCarry << 7);
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x1e:
-		temp = Read8(HL);
-		carry = temp & 0b1;
-		temp = (temp >> 1) | (fCarry << 7);
-		fZero = (temp == 0);
-		Write8(HL, temp);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x1f:
-		carry = A & 0b1;
-		A = (A >> 1) | (fCarry << 7);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x20:
-		carry = B >> 7;
-		B = (B << 1);
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x21:
-		carry = C >> 7;
-		C = (C << 1);
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x22:
-		carry = D >> 7;
-		D = (D << 1);
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x23:
-		carry = E >> 7;
-		E = (E << 1);
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x24:
-		carry = H >> 7;
-		H = (H << 1);
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x25:
-		carry = L >> 7;
-		L = (L << 1);
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x26:
-		temp = Read8(HL);
-		carry = temp >> 7;
-		temp = (temp << 1);
-		Write8(HL, temp);
-		fZero = ((temp & 0xff) == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x27:
-		carry = A >> 7;
-		A = (A << 1);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x28:
-		carry = B & 0b1;
-		sign = B & (0b1 << 7);
-		B = (B >> 1) | sign;
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x29:
-		carry = C & 0b1;
-		sign = C & (0b1 << 7);
-		C = (C >> 1) | sign;
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x2a:
-		carry = D & 0b1;
-		sign = D & (0b1 << 7);
-		D = (D >> 1) | sign;
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x2b:
-		carry = E & 0b1;
-		sign = E & (0b1 << 7);
-		E = (E >> 1) | sign;
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x2c:
-		carry = H & 0b1;
-		sign = H & (0b1 << 7);
-		H = (H >> 1) | sign;
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x2d:
-		carry = L & 0b1;
-		sign = L & (0b1 << 7);
-		L = (L >> 1) | sign;
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x2e:
-		temp = Read8(HL);
-		carry = temp & 0b1;
-		sign = temp & (0b1 << 7);
-		temp = (temp >> 1) | sign;
-		Write8(HL, temp);
-		fZero = (temp == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x2f:
-		carry = A & 0b1;
-		sign = A & (0b1 << 7);
-		A = (A >> 1) | sign;
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x30:
-		B = (B >> 4) | ((B << 4) & 0xf0);
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x31:
-		C = (C >> 4) | ((C << 4) & 0xf0);
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x32:
-		D = (D >> 4) | ((D << 4) & 0xf0);
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x33:
-		E = (E >> 4) | ((E << 4) & 0xf0);
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x34:
-		H = (H >> 4) | ((H << 4) & 0xf0);
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x35:
-		L = (L >> 4) | ((L << 4) & 0xf0);
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x36:
-		temp = Read8(HL);
-		temp = (temp >> 4) | ((temp << 4) & 0xf0);
-		Write8(HL, temp);
-		fZero = (temp == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x37:
-		A = (A >> 4) | ((A << 4) & 0xf0);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = 0;
-		break;
-	case 0x38:
-		carry = B & 0b1;
-		B = (B >> 1);
-		fZero = (B == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x39:
-		carry = C & 0b1;
-		C = (C >> 1);
-		fZero = (C == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x3a:
-		carry = D & 0b1;
-		D = (D >> 1);
-		fZero = (D == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x3b:
-		carry = E & 0b1;
-		E = (E >> 1);
-		fZero = (E == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x3c:
-		carry = H & 0b1;
-		H = (H >> 1);
-		fZero = (H == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x3d:
-		carry = L & 0b1;
-		L = (L >> 1);
-		fZero = (L == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x3e:
-		temp = Read8(HL);
-		carry = temp & 0b1;
-		temp = (temp >> 1);
-		Write8(HL, temp);
-		fZero = (temp == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x3f:
-		carry = A & 0b1;
-		A = (A >> 1);
-		fZero = (A == 0);
-		fSub = 0;
-		fHalfCarry = 0;
-		fCarry = carry;
-		break;
-	case 0x40:
-		fZero = ((B >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x41:
-		fZero = ((C >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x42:
-		fZero = ((D >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x43:
-		fZero = ((E >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x44:
-		fZero = ((H >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x45:
-		fZero = ((L >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x46:
-		fZero = ((Read8(HL) >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x47:
-		fZero = ((A >> 0) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x48:
-		fZero = ((B >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x49:
-		fZero = ((C >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x4a:
-		fZero = ((D >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x4b:
-		fZero = ((E >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x4c:
-		fZero = ((H >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x4d:
-		fZero = ((L >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x4e:
-		fZero = ((Read8(HL) >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x4f:
-		fZero = ((A >> 1) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x50:
-		fZero = ((B >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x51:
-		fZero = ((C >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x52:
-		fZero = ((D >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x53:
-		fZero = ((E >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x54:
-		fZero = ((H >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x55:
-		fZero = ((L >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x56:
-		fZero = ((Read8(HL) >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x57:
-		fZero = ((A >> 2) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x58:
-		fZero = ((B >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x59:
-		fZero = ((C >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x5a:
-		fZero = ((D >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x5b:
-		fZero = ((E >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x5c:
-		fZero = ((H >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x5d:
-		fZero = ((L >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x5e:
-		fZero = ((Read8(HL) >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x5f:
-		fZero = ((A >> 3) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x60:
-		fZero = ((B >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x61:
-		fZero = ((C >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x62:
-		fZero = ((D >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x63:
-		fZero = ((E >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x64:
-		fZero = ((H >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x65:
-		fZero = ((L >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x66:
-		fZero = ((Read8(HL) >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x67:
-		fZero = ((A >> 4) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x68:
-		fZero = ((B >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x69:
-		fZero = ((C >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x6a:
-		fZero = ((D >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x6b:
-		fZero = ((E >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x6c:
-		fZero = ((H >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x6d:
-		fZero = ((L >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x6e:
-		fZero = ((Read8(HL) >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x6f:
-		fZero = ((A >> 5) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x70:
-		fZero = ((B >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x71:
-		fZero = ((C >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x72:
-		fZero = ((D >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x73:
-		fZero = ((E >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x74:
-		fZero = ((H >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x75:
-		fZero = ((L >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x76:
-		fZero = ((Read8(HL) >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x77:
-		fZero = ((A >> 6) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x78:
-		fZero = ((B >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x79:
-		fZero = ((C >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x7a:
-		fZero = ((D >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x7b:
-		fZero = ((E >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x7c:
-		fZero = ((H >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x7d:
-		fZero = ((L >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x7e:
-		fZero = ((Read8(HL) >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x7f:
-		fZero = ((A >> 7) & 0b1) == 0;
-		fSub = 0;
-		fHalfCarry = 1;
-		break;
-	case 0x80:
-		B &= ~(1 << 0);
-		break;
-	case 0x81:
-		C &= ~(1 << 0);
-		break;
-	case 0x82:
-		D &= ~(1 << 0);
-		break;
-	case 0x83:
-		E &= ~(1 << 0);
-		break;
-	case 0x84:
-		H &= ~(1 << 0);
-		break;
-	case 0x85:
-		L &= ~(1 << 0);
-		break;
-	case 0x86:
-		Write8(HL, Read8(HL) & ~(1 << 0));
-		break;
-	case 0x87:
-		A &= ~(1 << 0);
-		break;
-	case 0x88:
-		B &= ~(1 << 1);
-		break;
-	case 0x89:
-		C &= ~(1 << 1);
-		break;
-	case 0x8a:
-		D &= ~(1 << 1);
-		break;
-	case 0x8b:
-		E &= ~(1 << 1);
-		break;
-	case 0x8c:
-		H &= ~(1 << 1);
-		break;
-	case 0x8d:
-		L &= ~(1 << 1);
-		break;
-	case 0x8e:
-		Write8(HL, Read8(HL) & ~(1 << 1));
-		break;
-	case 0x8f:
-		A &= ~(1 << 1);
-		break;
-	case 0x90:
-		B &= ~(1 << 2);
-		break;
-	case 0x91:
-		C &= ~(1 << 2);
-		break;
-	case 0x92:
-		D &= ~(1 << 2);
-		break;
-	case 0x93:
-		E &= ~(1 << 2);
-		break;
-	case 0x94:
-		H &= ~(1 << 2);
-		break;
-	case 0x95:
-		L &= ~(1 << 2);
-		break;
-	case 0x96:
-		Write8(HL, Read8(HL) & ~(1 << 2));
-		break;
-	case 0x97:
-		A &= ~(1 << 2);
-		break;
-	case 0x98:
-		B &= ~(1 << 3);
-		break;
-	case 0x99:
-		C &= ~(1 << 3);
-		break;
-	case 0x9a:
-		D &= ~(1 << 3);
-		break;
-	case 0x9b:
-		E &= ~(1 << 3);
-		break;
-	case 0x9c:
-		H &= ~(1 << 3);
-		break;
-	case 0x9d:
-		L &= ~(1 << 3);
-		break;
-	case 0x9e:
-		Write8(HL, Read8(HL) & ~(1 << 3));
-		break;
-	case 0x9f:
-		A &= ~(1 << 3);
-		break;
-	case 0xa0:
-		B &= ~(1 << 4);
-		break;
-	case 0xa1:
-		C &= ~(1 << 4);
-		break;
-	case 0xa2:
-		D &= ~(1 << 4);
-		break;
-	case 0xa3:
-		E &= ~(1 << 4);
-		break;
-	case 0xa4:
-		H &= ~(1 << 4);
-		break;
-	case 0xa5:
-		L &= ~(1 << 4);
-		break;
-	case 0xa6:
-		Write8(HL, Read8(HL) & ~(1 << 4));
-		break;
-	case 0xa7:
-		A &= ~(1 << 4);
-		break;
-	case 0xa8:
-		B &= ~(1 << 5);
-		break;
-	case 0xa9:
-		C &= ~(1 << 5);
-		break;
-	case 0xaa:
-		D &= ~(1 << 5);
-		break;
-	case 0xab:
-		E &= ~(1 << 5);
-		break;
-	case 0xac:
-		H &= ~(1 << 5);
-		break;
-	case 0xad:
-		L &= ~(1 << 5);
-		break;
-	case 0xae:
-		Write8(HL, Read8(HL) & ~(1 << 5));
-		break;
-	case 0xaf:
-		A &= ~(1 << 5);
-		break;
-	case 0xb0:
-		B &= ~(1 << 6);
-		break;
-	case 0xb1:
-		C &= ~(1 << 6);
-		break;
-	case 0xb2:
-		D &= ~(1 << 6);
-		break;
-	case 0xb3:
-		E &= ~(1 << 6);
-		break;
-	case 0xb4:
-		H &= ~(1 << 6);
-		break;
-	case 0xb5:
-		L &= ~(1 << 6);
-		break;
-	case 0xb6:
-		Write8(HL, Read8(HL) & ~(1 << 6));
-		break;
-	case 0xb7:
-		A &= ~(1 << 6);
-		break;
-	case 0xb8:
-		B &= ~(1 << 7);
-		break;
-	case 0xb9:
-		C &= ~(1 << 7);
-		break;
-	case 0xba:
-		D &= ~(1 << 7);
-		break;
-	case 0xbb:
-		E &= ~(1 << 7);
-		break;
-	case 0xbc:
-		H &= ~(1 << 7);
-		break;
-	case 0xbd:
-		L &= ~(1 << 7);
-		break;
-	case 0xbe:
-		Write8(HL, Read8(HL) & ~(1 << 7));
-		break;
-	case 0xbf:
-		A &= ~(1 << 7);
-		break;
-	case 0xc0:
-		B |= (1 << 0);
-		break;
-	case 0xc1:
-		C |= (1 << 0);
-		break;
-	case 0xc2:
-		D |= (1 << 0);
-		break;
-	case 0xc3:
-		E |= (1 << 0);
-		break;
-	case 0xc4:
-		H |= (1 << 0);
-		break;
-	case 0xc5:
-		L |= (1 << 0);
-		break;
-	case 0xc6:
-		Write8(HL, Read8(HL) | (1 << 0));
-		break;
-	case 0xc7:
-		A |= (1 << 0);
-		break;
-	case 0xc8:
-		B |= (1 << 1);
-		break;
-	case 0xc9:
-		C |= (1 << 1);
-		break;
-	case 0xca:
-		D |= (1 << 1);
-		break;
-	case 0xcb:
-		E |= (1 << 1);
-		break;
-	case 0xcc:
-		H |= (1 << 1);
-		break;
-	case 0xcd:
-		L |= (1 << 1);
-		break;
-	case 0xce:
-		Write8(HL, Read8(HL) | (1 << 1));
-		break;
-	case 0xcf:
-		A |= (1 << 1);
-		break;
-	case 0xd0:
-		B |= (1 << 2);
-		break;
-	case 0xd1:
-		C |= (1 << 2);
-		break;
-	case 0xd2:
-		D |= (1 << 2);
-		break;
-	case 0xd3:
-		E |= (1 << 2);
-		break;
-	case 0xd4:
-		H |= (1 << 2);
-		break;
-	case 0xd5:
-		L |= (1 << 2);
-		break;
-	case 0xd6:
-		Write8(HL, Read8(HL) | (1 << 2));
-		break;
-	case 0xd7:
-		A |= (1 << 2);
-		break;
-	case 0xd8:
-		B |= (1 << 3);
-		break;
-	case 0xd9:
-		C |= (1 << 3);
-		break;
-	case 0xda:
-		D |= (1 << 3);
-		break;
-	case 0xdb:
-		E |= (1 << 3);
-		break;
-	case 0xdc:
-		H |= (1 << 3);
-		break;
-	case 0xdd:
-		L |= (1 << 3);
-		break;
-	case 0xde:
-		Write8(HL, Read8(HL) | (1 << 3));
-		break;
-	case 0xdf:
-		A |= (1 << 3);
-		break;
-	case 0xe0:
-		B |= (1 << 4);
-		break;
-	case 0xe1:
-		C |= (1 << 4);
-		break;
-	case 0xe2:
-		D |= (1 << 4);
-		break;
-	case 0xe3:
-		E |= (1 << 4);
-		break;
-	case 0xe4:
-		H |= (1 << 4);
-		break;
-	case 0xe5:
-		L |= (1 << 4);
-		break;
-	case 0xe6:
-		Write8(HL, Read8(HL) | (1 << 4));
-		break;
-	case 0xe7:
-		A |= (1 << 4);
-		break;
-	case 0xe8:
-		B |= (1 << 5);
-		break;
-	case 0xe9:
-		C |= (1 << 5);
-		break;
-	case 0xea:
-		D |= (1 << 5);
-		break;
-	case 0xeb:
-		E |= (1 << 5);
-		break;
-	case 0xec:
-		H |= (1 << 5);
-		break;
-	case 0xed:
-		L |= (1 << 5);
-		break;
-	case 0xee:
-		Write8(HL, Read8(HL) | (1 << 5));
+// Interruptions are only raised when components synchronize at a scheduler
+// deadline, so a halted CPU goes straight to the next deadline or to the end of
+// the budget, still in 4 cycle steps.
+uint32_t CPU::SkipHalt(uint32_t cycles) {
+	if (IF & IE & 0x1f) return Step();
+	Scheduler& scheduler = bus.scheduler;
+	uint64_t skip = scheduler.NextDeadline() - scheduler.Now();
+	if (skip > cycles) skip = cycles;
+	skip = (skip + 3) & ~3ull;
+	return skip ? (uint32_t)skip : 4;
+}
+
+// Memory a polling loop may read: while the CPU runs, nothing but the CPU itself
+// or a synchronization at a scheduler deadline changes it.
+static bool IsIdleReadable(uint16_t address) {
+	if (address < 0x8000 || (address >= 0xc000 && address < 0xfe00) || address >= 0xff80) return true;
+	switch (address) {
+	case 0xff00: case 0xff0f: case 0xff40: case 0xff41: case 0xff42: case 0xff43: case 0xff44: case 0xff45:
+	case 0xff47: case 0xff48: case 0xff49: case 0xff4a: case 0xff4b:
+		return true;
+	}
+	return false;
+}
+
+static bool IsIdleCode(uint16_t address) {
+	return address < 0x8000 || (address >= 0xc000 && address < 0xe000) || (address >= 0xff80 && address < 0xffff);
+}
+
+int32_t CPU::JumpTarget(uint8_t opcode, uint16_t operand, uint16_t next) {
+	switch (opcode) {
+	case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+		return (uint16_t)(next + (int8_t)operand);
+	case 0xc2: case 0xc3: case 0xca: case 0xd2: case 0xda:
+		return operand;
+	}
+	return -1;
+}
+
+// An idle loop is a straight run of loads, compares and bit tests on idle
+// readable memory closed by the jump back to its head. Registers used as
+// pointers are checked before every skip.
+bool CPU::AnalyzeIdleLoop(uint16_t head, uint16_t end) {
+	idleLoop = IdleLoop();
+	idleLoop.head = head;
+	idleLoop.end = end;
+	if (!IsIdleCode(head) || !IsIdleCode(end - 1)) return false;
+
+	uint16_t address = head;
+	while (address < end) {
+		uint8_t opcode = bus.Read8(address);
+		uint8_t length = opcode == 0xcb ? 2 : baseOpcodeTable[opcode].length;
+		uint16_t operand = 0;
+		if (length >= 2) operand = bus.Read8(address + 1);
+		if (length == 3) operand |= bus.Read8(address + 2) << 8;
+		address += length;
+		idleLoop.instructions++;
+		if (address == end) {
+			idleLoop.idle = JumpTarget(opcode, operand, address) == head;
+			return idleLoop.idle;
+		}
+
+		switch (opcode) {
+		case 0x00: case 0x07: case 0x0f: case 0x17: case 0x1f: case 0x2f: case 0x37: case 0x3f:
+		case 0x06: case 0x0e: case 0x16: case 0x1e: case 0x26: case 0x2e: case 0x3e:
+		case 0xc6: case 0xce: case 0xd6: case 0xde: case 0xe6: case 0xee: case 0xf6: case 0xfe:
+			break;
+		case 0x0a:
+			idleLoop.readsBC = true;
+			break;
+		case 0x1a:
+			idleLoop.readsDE = true;
+			break;
+		case 0xf2:
+			idleLoop.readsC = true;
+			break;
+		case 0xf0:
+			if (!IsIdleReadable(0xff00 | operand)) return false;
+			break;
+		case 0xfa:
+			if (!IsIdleReadable(operand)) return false;
+			break;
+		case 0xcb:
+			if ((operand & 7) == 6) {
+				if (operand < 0x40 || operand >= 0x80) return false;
+				idleLoop.readsHL = true;
+			}
+			break;
+		default:
+			if (opcode < 0x40 || opcode >= 0xc0 || (opcode >= 0x70 && opcode < 0x78)) return false;
+			if ((opcode & 7) == 6) idleLoop.readsHL = true;
+			break;
+		}
+	}
+	return false;
+}
+
+// Once an idle loop comes back to its head without any change, every following
+// iteration repeats it until a synchronization changes the polled memory, so
+// whole iterations are skipped up to the next deadline or the end of the run.
+void CPU::SkipIdleLoop(uint16_t head) {
+	if (head != idleLoop.head || PC != idleLoop.end) {
+		if (!AnalyzeIdleLoop(head, PC)) return;
+	}
+	Scheduler& scheduler = bus.scheduler;
+	uint64_t now = scheduler.Now() + stepClock;
+	ResolveFlags();
+	// A deadline inside the last iteration may have changed memory it had already read.
+	bool repeated = idleLoop.observed && now < idleLoop.deadline && instructions - idleLoop.instructionCount == idleLoop.instructions &&
+		AF == idleLoop.AF && BC == idleLoop.BC && DE == idleLoop.DE && HL == idleLoop.HL && SP == idleLoop.SP && IME == idleLoop.IME;
+	if (repeated && !(IME && (IF & IE & 0x1f)) &&
+		(!idleLoop.readsBC || IsIdleReadable(BC)) && (!idleLoop.readsDE || IsIdleReadable(DE)) &&
+		(!idleLoop.readsHL || IsIdleReadable(HL)) && (!idleLoop.readsC || IsIdleReadable(0xff00 | C))) {
+		uint64_t limit = scheduler.NextDeadline() < runEnd ? scheduler.NextDeadline() : runEnd;
+		uint64_t period = now - idleLoop.timestamp;
+		uint64_t iterations = limit > now ? (limit - now - 1) / period : 0;
+		if (iterations) {
+			uint32_t skipped = (uint32_t)(iterations * period);
+			stepClock += skipped;
+			instructions += iterations * idleLoop.instructions;
+			now += skipped;
+			idleLoopSkips++;
+			idleCyclesSkipped += skipped;
+		}
+	}
+
+	idleLoop.observed = true;
+	idleLoop.timestamp = now;
+	idleLoop.deadline = scheduler.NextDeadline();
+	idleLoop.instructionCount = instructions;
+	idleLoop.AF = AF;
+	idleLoop.BC = BC;
+	idleLoop.DE = DE;
+	idleLoop.HL = HL;
+	idleLoop.SP = SP;
+	idleLoop.IME = IME;
+}
+
+uint32_t CPU::Run(uint32_t cycles) {
+	runEnd = bus.scheduler.Now() + cycles;
+	uint32_t elapsed = dispatch == CPUDispatch::JIT ? RunJIT(cycles) : RunInterpreter(cycles);
+	runEnd = 0;
+	ResolveFlags();
+	return elapsed;
+}
+
+uint32_t CPU::RunInterpreter(uint32_t cycles) {
+	if (dispatch == CPUDispatch::Cached) return RunCached(cycles);
+#ifdef GBC_THREADED_DISPATCH
+	if (dispatch != CPUDispatch::Switch) return RunThreaded(cycles);
+#endif
+	Scheduler& scheduler = bus.scheduler;
+	uint32_t elapsed = 0;
+	do {
+		uint32_t stepCycles = isHalting ? SkipHalt(cycles - elapsed) : Step();
+		elapsed += stepCycles;
+		if (scheduler.Advance(stepCycles)) break;
+	} while (elapsed < cycles);
+	return elapsed;
+}
+
+// Cached interpreter: instructions come predecoded from the instruction cache,
+// and execution follows the records of a page while it falls through them.
+uint32_t CPU::RunCached(uint32_t cycles) {
+	Scheduler& scheduler = bus.scheduler;
+	uint32_t elapsed = 0;
+	do {
+		const DecodedInstruction* instruction = nullptr;
+		if (!((IME && (IF & IE & 0x1f)) || isHalting || haltBug || logAssembler)) instruction = instructionCache.Lookup(PC);
+		if (!instruction) {
+			uint32_t stepCycles = isHalting ? SkipHalt(cycles - elapsed) : Step();
+			elapsed += stepCycles;
+			if (scheduler.Advance(stepCycles)) break;
+			continue;
+		}
+		while (true) {
+			bool endsBlock = instruction->endsBlock;
+			uint16_t next = PC + instruction->length;
+			opcode = instruction->opcode;
+			PC = next;
+			stepClock += instruction->cycles;
+			if (opcode == 0xcb) {
+				secondaryOpcode = (uint8_t)instruction->operand;
+				ExecutePrefixInline();
+			}
+			else {
+				if (instruction->length == 2) attr8 = (uint8_t)instruction->operand;
+				else if (instruction->length == 3) attr16 = instruction->operand;
+				ExecuteInline();
+			}
+
+			uint32_t stepCycles = stepClock;
+			stepClock = 0;
+			clock += stepCycles;
+			instructions++;
+			elapsed += stepCycles;
+			if (scheduler.Advance(stepCycles) | (elapsed >= cycles)) return elapsed;
+			if (endsBlock || PC != next || (IME && (IF & IE & 0x1f)) || isHalting) break;
+			instruction += instruction->length;
+			if (!instruction->length || instruction->crossesPage) break;
+		}
+	} while (elapsed < cycles);
+	return elapsed;
+}
+
+// Translated blocks only touch registers and plain RAM, so a block may run whole
+// whenever neither the budget nor the next deadline can fall inside it. A block
+// that stops at its first instruction leaves that instruction to the interpreter.
+uint32_t CPU::RunJIT(uint32_t cycles) {
+	Scheduler& scheduler = bus.scheduler;
+	uint32_t elapsed = 0;
+	do {
+		JITBlock* block = nullptr;
+		if (!((IME && (IF & IE & 0x1f)) || isHalting || haltBug || logAssembler)) block = jit.Lookup(PC);
+		uint32_t blockCycles = 0;
+		if (block && elapsed + block->maxCycles < cycles && scheduler.Now() + block->maxCycles < scheduler.NextDeadline()) {
+			blockCycles = jit.Execute(*block);
+		}
+		if (blockCycles) {
+			elapsed += blockCycles;
+			if (scheduler.Advance(blockCycles)) break;
+		}
+		else if (isHalting) {
+			uint32_t stepCycles = SkipHalt(cycles - elapsed);
+			elapsed += stepCycles;
+			if (scheduler.Advance(stepCycles)) break;
+		}
+		else {
+			elapsed += RunInterpreter(1);
+			if (scheduler.DeadlineReached()) break;
+		}
+	} while (elapsed < cycles);
+	return elapsed;
+}
+
+// Drops translations and decoded instructions of a page whose bytes changed.
+void CPU::InvalidateCode(uint8_t page) {
+	jit.InvalidatePage(page);
+	instructionCache.InvalidatePage(page);
+	idleLoop = IdleLoop();
+}
+
+void CPU::FlushCode() {
+	jit.Flush();
+	instructionCache.Flush();
+	bus.ClearCodePages();
+	idleLoop = IdleLoop();
+}
+
+bool CPU::HandleInterruptions() {
+	uint8_t interruptions = IF & IE & 0x1f;
+	if (!interruptions) return false;
+	isHalting = false;
+	if (!IME) return false;
+
+	if (interruptions & (uint8_t)Interruption::VBlank) {
+		IF &= ~(uint8_t)Interruption::VBlank;
+		HandleInterruption(0x40);
+	}
+	else if (interruptions & (uint8_t)Interruption::LCD) {
+		IF &= ~(uint8_t)Interruption::LCD;
+		HandleInterruption(0x48);
+	}
+	else if (interruptions & (uint8_t)Interruption::Timer) {
+		IF &= ~(uint8_t)Interruption::Timer;
+		HandleInterruption(0x50);
+	}
+	else if (interruptions & (uint8_t)Interruption::Serial) {
+		IF &= ~(uint8_t)Interruption::Serial;
+		HandleInterruption(0x58);
+	}
+	else if (interruptions & (uint8_t)Interruption::Joypad) {
+		IF &= ~(uint8_t)Interruption::Joypad;
+		HandleInterruption(0x60);
+	}
+
+	return true;
+}
+
+void CPU::HandleInterruption(uint16_t handlerAddress) {
+	IME = 0;
+	Push16(PC);
+	PC = handlerAddress;
+}
+
+// Help Instructions
+uint8_t CPU::GetR8(uint8_t index) {
+	switch (index & 0b111) {
+	case 0:
+		return B;
+	case 1:
+		return C;
+	case 2:
+		return D;
+	case 3:
+		return E;
+	case 4:
+		return H;
+	case 5:
+		return L;
+	case 6:
+		CoreLog() << "Error: Read from register at index 6 should be using [HL] instructions.\n";
+		return 0;
+	case 7:
+		return A;
+	}
+	return 0;
+}
+
+void CPU::SetR8(uint8_t index, uint8_t value) {
+	switch (index & 0b111) {
+	case 0:
+		B = value;
 		break;
-	case 0xef:
-		A |= (1 << 5);
+	case 1:
+		C = value;
 		break;
-	case 0xf0:
-		B |= (1 << 6);
+	case 2:
+		D = value;
 		break;
-	case 0xf1:
-		C |= (1 << 6);
+	case 3:
+		E = value;
 		break;
-	case 0xf2:
-		D |= (1 << 6);
+	case 4:
+		H = value;
 		break;
-	case 0xf3:
-		E |= (1 << 6);
+	case 5:
+		L = value;
 		break;
-	case 0xf4:
-		H |= (1 << 6);
+	case 6:
+		CoreLog() << "Error: Write to register at index 6 should be using [HL] instructions.\n";
 		break;
-	case 0xf5:
-		L |= (1 << 6);
+	case 7:
+		A = value;
 		break;
-	case 0xf6:
-		Write8(HL, Read8(HL) | (1 << 6));
+	}
+}
+
+uint16_t CPU::GetR16(uint8_t index) {
+	switch (index & 0b11) {
+	case 0:
+		return BC;
+	case 1:
+		return DE;
+	case 2:
+		return HL;
+	case 3:
+		if (opcode >> 7) {
+			return AF;
+		}
+		else {
+			return SP;
+		}
+	}
+	return 0;
+}
+
+void CPU::SetR16(uint8_t index, uint16_t value) {
+	switch (index & 0b11) {
+	case 0:
+		BC = value;
 		break;
-	case 0xf7:
-		A |= (1 << 6);
+	case 1:
+		DE = value;
 		break;
-	case 0xf8:
-		B |= (1 << 7);
+	case 2:
+		HL = value;
 		break;
-	case 0xf9:
-		C |= (1 << 7);
+	case 3:
+		if (opcode >> 7) {
+			AF = value & 0xfff0;
+		}
+		else {
+			SP = value;
+		}
 		break;
-	case 0xfa:
-		D |= (1 << 7);
+	}
+}
+
+uint8_t CPU::Read8(uint16_t address) {
+	return bus.Read8(address);
+}
+
+void CPU::Write8(uint16_t address, uint8_t value) {
+	bus.Write8(address, value);
+}
+
+uint16_t CPU::Read16(uint16_t address) {
+	return bus.Read16(address);
+}
+
+void CPU::Write16(uint16_t address, uint16_t value) {
+	bus.Write16(address, value);
+}
+
+uint16_t CPU::Pop16() {
+	SP += 2;
+	return bus.Read16(SP - 2);
+}
+
+void CPU::Push16(uint16_t value) {
+	SP -= 2;
+	bus.Write16(SP, value);
+}
+
+void CPU::WriteState(SaveState& state) {
+	ResolveFlags();
+	state.Write16(AF);
+	state.Write16(BC);
+	state.Write16(DE);
+	state.Write16(HL);
+	state.Write16(SP);
+	state.Write8(IF);
+	state.Write8(IE);
+	state.Write8(IME);
+	state.Write8(isHalting);
+	state.Write8(haltBug);
+	state.Write8(key1);
+}
+
+void CPU::LoadState(SaveState& state) {
+	ResolveFlags();
+	AF = state.Read16();
+	BC = state.Read16();
+	DE = state.Read16();
+	HL = state.Read16();
+	SP = state.Read16();
+	IF = state.Read8();
+	IE = state.Read8();
+	IME = state.Read8();
+	isHalting = state.Read8();
+	haltBug = state.Read8();
+	key1 = state.Read8();
+	FlushCode();
+}
+
+#ifdef GBC_LAZY_FLAGS
+void CPU::ResolveLazyFlags() {
+	switch (flagOperation) {
+	case FlagOperation::Add:
+		WriteAddFlags(flagLeft, flagRight, flagCarry, flagResult);
 		break;
-	case 0xfb:
-		E |= (1 << 7);
+	case FlagOperation::Sub:
+		WriteSubFlags(flagLeft, flagRight, flagCarry, flagResult);
 		break;
-	case 0xfc:
-		H |= (1 << 7);
+	case FlagOperation::And:
+	case FlagOperation::Or:
+		WriteLogicFlags(flagResult, flagOperation == FlagOperation::And);
 		break;
-	case 0xfd:
-		L |= (1 << 7);
+	case FlagOperation::Inc:
+		fCarry = flagCarry;
+		WriteIncFlags(flagResult);
 		break;
-	case 0xfe:
-		Write8(HL, Read8(HL) | (1 << 7));
+	case FlagOperation::Dec:
+		fCarry = flagCarry;
+		WriteDecFlags(flagResult);
 		break;
-	case 0xff:
-		A |= (1 << 7);
+	default:
 		break;
+	}
+	flagOperation = FlagOperation::None;
+}
+#endif
+
+bool CPU::CheckCondition(uint8_t condition) {
+	switch (condition & 0b11) {
+	case 0:
+		return !fZero;
+	case 1:
+		return fZero;
+	case 2:
+		return !fCarry;
+	case 3:
+		return fCarry;
+	}
+	return false;
+}
+
+void CPU::ExecuteThroughTable() {
+	(this->*baseOpcodeTable[opcode].inst)();
+}
+
+#define INSTRUCTION(code, length) case code:
+#define PREFIX_INSTRUCTION(code) case code:
+#define END_INSTRUCTION break
+#define EXECUTE_PREFIX() ExecutePrefixInline()
+
+void CPU::ExecuteInline() {
+	uint32_t result, temp;
+	uint8_t carry;
+
+	switch (opcode) {
+#include "CPUInstructions.inl"
+	default:
+		CoreLog() << "Unhandled instruction: 0x" << std::hex << (uint32_t)opcode << "\n";
+		ExecuteThroughTable();
+	}
+}
+
+void CPU::ExecutePrefixThroughTable() {
+	(this->*prefixOpcodeTable[secondaryOpcode].inst)();
+}
+
+void CPU::ExecutePrefixInline() {
+	uint8_t carry, sign;
+	uint32_t temp;
+	switch (secondaryOpcode) {
+#include "CPUPrefixInstructions.inl"
 	default:
-		std::cout << "Unhandled CPU instruction. Will execute through table: 0x" << std::hex << opcode << std::dec << "\n";
+		CoreLog() << "Unhandled CPU instruction. Will execute through table: 0x" << std::hex << opcode << std::dec << "\n";
 		ExecutePrefixThroughTable();
 	}
 }
 
+#undef INSTRUCTION
+#undef PREFIX_INSTRUCTION
+#undef END_INSTRUCTION
+#undef EXECUTE_PREFIX
+
+#ifdef GBC_THREADED_DISPATCH
+// Direct-threaded core: every handler fetches its own operands and jumps
+// straight to the next handler instead of returning to a central switch.
+// Interruptions, HALT, the HALT bug and logging are left to Step.
+uint32_t CPU::RunThreaded(uint32_t cycles) {
+	static const void* const instructionLabels[0x100] = {
+		&&instruction_0x00, &&instruction_0x01, &&instruction_0x02, &&instruction_0x03, &&instruction_0x04, &&instruction_0x05, &&instruction_0x06, &&instruction_0x07, &&instruction_0x08, &&instruction_0x09, &&instruction_0x0a, &&instruction_0x0b, &&instruction_0x0c, &&instruction_0x0d, &&instruction_0x0e, &&instruction_0x0f,
+		&&instruction_0x10, &&instruction_0x11, &&instruction_0x12, &&instruction_0x13, &&instruction_0x14, &&instruction_0x15, &&instruction_0x16, &&instruction_0x17, &&instruction_0x18, &&instruction_0x19, &&instruction_0x1a, &&instruction_0x1b, &&instruction_0x1c, &&instruction_0x1d, &&instruction_0x1e, &&instruction_0x1f,
+		&&instruction_0x20, &&instruction_0x21, &&instruction_0x22, &&instruction_0x23, &&instruction_0x24, &&instruction_0x25, &&instruction_0x26, &&instruction_0x27, &&instruction_0x28, &&instruction_0x29, &&instruction_0x2a, &&instruction_0x2b, &&instruction_0x2c, &&instruction_0x2d, &&instruction_0x2e, &&instruction_0x2f,
+		&&instruction_0x30, &&instruction_0x31, &&instruction_0x32, &&instruction_0x33, &&instruction_0x34, &&instruction_0x35, &&instruction_0x36, &&instruction_0x37, &&instruction_0x38, &&instruction_0x39, &&instruction_0x3a, &&instruction_0x3b, &&instruction_0x3c, &&instruction_0x3d, &&instruction_0x3e, &&instruction_0x3f,
+		&&instruction_0x40, &&instruction_0x41, &&instruction_0x42, &&instruction_0x43, &&instruction_0x44, &&instruction_0x45, &&instruction_0x46, &&instruction_0x47, &&instruction_0x48, &&instruction_0x49, &&instruction_0x4a, &&instruction_0x4b, &&instruction_0x4c, &&instruction_0x4d, &&instruction_0x4e, &&instruction_0x4f,
+		&&instruction_0x50, &&instruction_0x51, &&instruction_0x52, &&instruction_0x53, &&instruction_0x54, &&instruction_0x55, &&instruction_0x56, &&instruction_0x57, &&instruction_0x58, &&instruction_0x59, &&instruction_0x5a, &&instruction_0x5b, &&instruction_0x5c, &&instruction_0x5d, &&instruction_0x5e, &&instruction_0x5f,
+		&&instruction_0x60, &&instruction_0x61, &&instruction_0x62, &&instruction_0x63, &&instruction_0x64, &&instruction_0x65, &&instruction_0x66, &&instruction_0x67, &&instruction_0x68, &&instruction_0x69, &&instruction_0x6a, &&instruction_0x6b, &&instruction_0x6c, &&instruction_0x6d, &&instruction_0x6e, &&instruction_0x6f,
+		&&instruction_0x70, &&instruction_0x71, &&instruction_0x72, &&instruction_0x73, &&instruction_0x74, &&instruction_0x75, &&instruction_0x76, &&instruction_0x77, &&instruction_0x78, &&instruction_0x79, &&instruction_0x7a, &&instruction_0x7b, &&instruction_0x7c, &&instruction_0x7d, &&instruction_0x7e, &&instruction_0x7f,
+		&&instruction_0x80, &&instruction_0x81, &&instruction_0x82, &&instruction_0x83, &&instruction_0x84, &&instruction_0x85, &&instruction_0x86, &&instruction_0x87, &&instruction_0x88, &&instruction_0x89, &&instruction_0x8a, &&instruction_0x8b, &&instruction_0x8c, &&instruction_0x8d, &&instruction_0x8e, &&instruction_0x8f,
+		&&instruction_0x90, &&instruction_0x91, &&instruction_0x92, &&instruction_0x93, &&instruction_0x94, &&instruction_0x95, &&instruction_0x96, &&instruction_0x97, &&instruction_0x98, &&instruction_0x99, &&instruction_0x9a, &&instruction_0x9b, &&instruction_0x9c, &&instruction_0x9d, &&instruction_0x9e, &&instruction_0x9f,
+		&&instruction_0xa0, &&instruction_0xa1, &&instruction_0xa2, &&instruction_0xa3, &&instruction_0xa4, &&instruction_0xa5, &&instruction_0xa6, &&instruction_0xa7, &&instruction_0xa8, &&instruction_0xa9, &&instruction_0xaa, &&instruction_0xab, &&instruction_0xac, &&instruction_0xad, &&instruction_0xae, &&instruction_0xaf,
+		&&instruction_0xb0, &&instruction_0xb1, &&instruction_0xb2, &&instruction_0xb3, &&instruction_0xb4, &&instruction_0xb5, &&instruction_0xb6, &&instruction_0xb7, &&instruction_0xb8, &&instruction_0xb9, &&instruction_0xba, &&instruction_0xbb, &&instruction_0xbc, &&instruction_0xbd, &&instruction_0xbe, &&instruction_0xbf,
+		&&instruction_0xc0, &&instruction_0xc1, &&instruction_0xc2, &&instruction_0xc3, &&instruction_0xc4, &&instruction_0xc5, &&instruction_0xc6, &&instruction_0xc7, &&instruction_0xc8, &&instruction_0xc9, &&instruction_0xca, &&instruction_0xcb, &&instruction_0xcc, &&instruction_0xcd, &&instruction_0xce, &&instruction_0xcf,
+		&&instruction_0xd0, &&instruction_0xd1, &&instruction_0xd2, &&unhandled, &&instruction_0xd4, &&instruction_0xd5, &&instruction_0xd6, &&instruction_0xd7, &&instruction_0xd8, &&instruction_0xd9, &&instruction_0xda, &&unhandled, &&instruction_0xdc, &&unhandled, &&instruction_0xde, &&instruction_0xdf,
+		&&instruction_0xe0, &&instruction_0xe1, &&instruction_0xe2, &&unhandled, &&unhandled, &&instruction_0xe5, &&instruction_0xe6, &&instruction_0xe7, &&instruction_0xe8, &&instruction_0xe9, &&instruction_0xea, &&unhandled, &&unhandled, &&unhandled, &&instruction_0xee, &&instruction_0xef,
+		&&instruction_0xf0, &&instruction_0xf1, &&instruction_0xf2, &&instruction_0xf3, &&unhandled, &&instruction_0xf5, &&instruction_0xf6, &&instruction_0xf7, &&instruction_0xf8, &&instruction_0xf9, &&instruction_0xfa, &&instruction_0xfb, &&unhandled, &&unhandled, &&instruction_0xfe, &&instruction_0xff,
+	};
+	static const void* const prefixInstructionLabels[0x100] = {
+		&&prefix_0x00, &&prefix_0x01, &&prefix_0x02, &&prefix_0x03, &&prefix_0x04, &&prefix_0x05, &&prefix_0x06, &&prefix_0x07, &&prefix_0x08, &&prefix_0x09, &&prefix_0x0a, &&prefix_0x0b, &&prefix_0x0c, &&prefix_0x0d, &&prefix_0x0e, &&prefix_0x0f,
+		&&prefix_0x10, &&prefix_0x11, &&prefix_0x12, &&prefix_0x13, &&prefix_0x14, &&prefix_0x15, &&prefix_0x16, &&prefix_0x17, &&prefix_0x18, &&prefix_0x19, &&prefix_0x1a, &&prefix_0x1b, &&prefix_0x1c, &&prefix_0x1d, &&prefix_0x1e, &&prefix_0x1f,
+		&&prefix_0x20, &&prefix_0x21, &&prefix_0x22, &&prefix_0x23, &&prefix_0x24, &&prefix_0x25, &&prefix_0x26, &&prefix_0x27, &&prefix_0x28, &&prefix_0x29, &&prefix_0x2a, &&prefix_0x2b, &&prefix_0x2c, &&prefix_0x2d, &&prefix_0x2e, &&prefix_0x2f,
+		&&prefix_0x30, &&prefix_0x31, &&prefix_0x32, &&prefix_0x33, &&prefix_0x34, &&prefix_0x35, &&prefix_0x36, &&prefix_0x37, &&prefix_0x38, &&prefix_0x39, &&prefix_0x3a, &&prefix_0x3b, &&prefix_0x3c, &&prefix_0x3d, &&prefix_0x3e, &&prefix_0x3f,
+		&&prefix_0x40, &&prefix_0x41, &&prefix_0x42, &&prefix_0x43, &&prefix_0x44, &&prefix_0x45, &&prefix_0x46, &&prefix_0x47, &&prefix_0x48, &&prefix_0x49, &&prefix_0x4a, &&prefix_0x4b, &&prefix_0x4c, &&prefix_0x4d, &&prefix_0x4e, &&prefix_0x4f,
+		&&prefix_0x50, &&prefix_0x51, &&prefix_0x52, &&prefix_0x53, &&prefix_0x54, &&prefix_0x55, &&prefix_0x56, &&prefix_0x57, &&prefix_0x58, &&prefix_0x59, &&prefix_0x5a, &&prefix_0x5b, &&prefix_0x5c, &&prefix_0x5d, &&prefix_0x5e, &&prefix_0x5f,
+		&&prefix_0x60, &&prefix_0x61, &&prefix_0x62, &&prefix_0x63, &&prefix_0x64, &&prefix_0x65, &&prefix_0x66, &&prefix_0x67, &&prefix_0x68, &&prefix_0x69, &&prefix_0x6a, &&prefix_0x6b, &&prefix_0x6c, &&prefix_0x6d, &&prefix_0x6e, &&prefix_0x6f,
+		&&prefix_0x70, &&prefix_0x71, &&prefix_0x72, &&prefix_0x73, &&prefix_0x74, &&prefix_0x75, &&prefix_0x76, &&prefix_0x77, &&prefix_0x78, &&prefix_0x79, &&prefix_0x7a, &&prefix_0x7b, &&prefix_0x7c, &&prefix_0x7d, &&prefix_0x7e, &&prefix_0x7f,
+		&&prefix_0x80, &&prefix_0x81, &&prefix_0x82, &&prefix_0x83, &&prefix_0x84, &&prefix_0x85, &&prefix_0x86, &&prefix_0x87, &&prefix_0x88, &&prefix_0x89, &&prefix_0x8a, &&prefix_0x8b, &&prefix_0x8c, &&prefix_0x8d, &&prefix_0x8e, &&prefix_0x8f,
+		&&prefix_0x90, &&prefix_0x91, &&prefix_0x92, &&prefix_0x93, &&prefix_0x94, &&prefix_0x95, &&prefix_0x96, &&prefix_0x97, &&prefix_0x98, &&prefix_0x99, &&prefix_0x9a, &&prefix_0x9b, &&prefix_0x9c, &&prefix_0x9d, &&prefix_0x9e, &&prefix_0x9f,
+		&&prefix_0xa0, &&prefix_0xa1, &&prefix_0xa2, &&prefix_0xa3, &&prefix_0xa4, &&prefix_0xa5, &&prefix_0xa6, &&prefix_0xa7, &&prefix_0xa8, &&prefix_0xa9, &&prefix_0xaa, &&prefix_0xab, &&prefix_0xac, &&prefix_0xad, &&prefix_0xae, &&prefix_0xaf,
+		&&prefix_0xb0, &&prefix_0xb1, &&prefix_0xb2, &&prefix_0xb3, &&prefix_0xb4, &&prefix_0xb5, &&prefix_0xb6, &&prefix_0xb7, &&prefix_0xb8, &&prefix_0xb9, &&prefix_0xba, &&prefix_0xbb, &&prefix_0xbc, &&prefix_0xbd, &&prefix_0xbe, &&prefix_0xbf,
+		&&prefix_0xc0, &&prefix_0xc1, &&prefix_0xc2, &&prefix_0xc3, &&prefix_0xc4, &&prefix_0xc5, &&prefix_0xc6, &&prefix_0xc7, &&prefix_0xc8, &&prefix_0xc9, &&prefix_0xca, &&prefix_0xcb, &&prefix_0xcc, &&prefix_0xcd, &&prefix_0xce, &&prefix_0xcf,
+		&&prefix_0xd0, &&prefix_0xd1, &&prefix_0xd2, &&prefix_0xd3, &&prefix_0xd4, &&prefix_0xd5, &&prefix_0xd6, &&prefix_0xd7, &&prefix_0xd8, &&prefix_0xd9, &&prefix_0xda, &&prefix_0xdb, &&prefix_0xdc, &&prefix_0xdd, &&prefix_0xde, &&prefix_0xdf,
+		&&prefix_0xe0, &&prefix_0xe1, &&prefix_0xe2, &&prefix_0xe3, &&prefix_0xe4, &&prefix_0xe5, &&prefix_0xe6, &&prefix_0xe7, &&prefix_0xe8, &&prefix_0xe9, &&prefix_0xea, &&prefix_0xeb, &&prefix_0xec, &&prefix_0xed, &&prefix_0xee, &&prefix_0xef,
+		&&prefix_0xf0, &&prefix_0xf1, &&prefix_0xf2, &&prefix_0xf3, &&prefix_0xf4, &&prefix_0xf5, &&prefix_0xf6, &&prefix_0xf7, &&prefix_0xf8, &&prefix_0xf9, &&prefix_0xfa, &&prefix_0xfb, &&prefix_0xfc, &&prefix_0xfd, &&prefix_0xfe, &&prefix_0xff,
+	};
+
+	Scheduler& scheduler = bus.scheduler;
+	uint32_t elapsed = 0;
+	uint32_t result, temp;
+	uint8_t carry, sign;
+
+fetch:
+	if ((IME && (IF & IE & 0x1f)) || isHalting || haltBug || logAssembler) {
+		uint32_t stepCycles = isHalting ? SkipHalt(cycles - elapsed) : Step();
+		elapsed += stepCycles;
+		if (scheduler.Advance(stepCycles) || elapsed >= cycles) return elapsed;
+		goto fetch;
+	}
+	opcode = Read8(PC++);
+	goto *instructionLabels[opcode];
+
+#define FETCH_OPERANDS_1
+#define FETCH_OPERANDS_2 attr8 = Read8(PC++);
+#define FETCH_OPERANDS_3 attr16 = Read16(PC); PC += 2;
+#define INSTRUCTION(code, length) instruction_##code: FETCH_OPERANDS_##length stepClock += opcodeTimingTable[code] * 4;
+#define PREFIX_INSTRUCTION(code) prefix_##code:
+#define END_INSTRUCTION goto next
+#define EXECUTE_PREFIX() goto *prefixInstructionLabels[secondaryOpcode]
+#include "CPUInstructions.inl"
+#include "CPUPrefixInstructions.inl"
+#undef FETCH_OPERANDS_1
+#undef FETCH_OPERANDS_2
+#undef FETCH_OPERANDS_3
+#undef INSTRUCTION
+#undef PREFIX_INSTRUCTION
+#undef END_INSTRUCTION
+#undef EXECUTE_PREFIX
+
+unhandled:
+	stepClock += opcodeTimingTable[opcode] * 4;
+	CoreLog() << "Unhandled instruction: 0x" << std::hex << (uint32_t)opcode << "\n";
+	ExecuteThroughTable();
+
+next:
+	elapsed += stepClock;
+	clock += stepClock;
+	instructions++;
+	if (scheduler.Advance(stepClock) | (elapsed >= cycles)) {
+		stepClock = 0;
+		return elapsed;
+	}
+	stepClock = 0;
+	goto fetch;
+}
+#endif
+
 // Custom Instruction
 void CPU::UNH() {
-	std::cout << "Unhandled CPU instruction: 0x" << std::hex << opcode << std::dec << "\n";
+	CoreLog() << "Unhandled CPU instruction: 0x" << std::hex << opcode << std::dec << "\n";
 }
 
 void CPU::PREFIX() {
@@ -3587,7 +1513,7 @@ void CPU::HALT() {
 	}
 	else {
 		if (IE & IF & 0x1f) {
-			std::cout << "HALT can bug out\n";
+			CoreLog() << "HALT can bug out\n";
 			haltBug = true;
 		}
 		else {
@@ -3606,9 +1532,6 @@ void CPU::SCF() {
 }
 
 void CPU::STOP() {
-	std::cout << "STOP: not implemented\n";
+	CoreLog() << "STOP: not implemented\n";
 	Write8(0xff04, 0);
 }
-
-CPU::Opcode::Opcode(const std::string& assembler, Instruction inst, uint8_t length, uint8_t clock, uint8_t mClock)
-	: assembler(assembler), inst(inst), length(length), clock(clock), mClock(mClock) {}
\ No newline at end of file
@@ -0,0 +1,1033 @@
+// Base SM83 instruction bodies shared by the CPU dispatch cores. The includer
+// defines INSTRUCTION(code, length), END_INSTRUCTION and EXECUTE_PREFIX().
+// Operands are expected in attr8/attr16 and base timing in stepClock when a
+// body starts; bodies only add the extra cycles of taken branches.
+INSTRUCTION(0x00, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x01, 3)
+	BC = attr16;
+	END_INSTRUCTION;
+INSTRUCTION(0x02, 1)
+	Write8(BC, A);
+	END_INSTRUCTION;
+INSTRUCTION(0x03, 1)
+	BC++;
+	END_INSTRUCTION;
+INSTRUCTION(0x04, 1)
+	B++;
+	SetIncFlags(B);
+	END_INSTRUCTION;
+INSTRUCTION(0x05, 1)
+	B--;
+	SetDecFlags(B);
+	END_INSTRUCTION;
+INSTRUCTION(0x06, 2)
+	B = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x07, 1)
+	ResolveFlags();
+	A = (A << 1) | (A >> 7);
+	fZero = 0;
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = A & 1;
+	END_INSTRUCTION;
+INSTRUCTION(0x08, 3)
+	Write16(attr16, SP);
+	END_INSTRUCTION;
+INSTRUCTION(0x09, 1)
+	ResolveFlags();
+	result = HL + BC;
+	fSub = 0;
+	fHalfCarry = ((HL & 0x0fff) + (BC & 0x0fff)) > 0x0fff;
+	fCarry = result > 0xffff;
+	HL = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x0a, 1)
+	A = Read8(BC);
+	END_INSTRUCTION;
+INSTRUCTION(0x0b, 1)
+	BC--;
+	END_INSTRUCTION;
+INSTRUCTION(0x0c, 1)
+	C++;
+	SetIncFlags(C);
+	END_INSTRUCTION;
+INSTRUCTION(0x0d, 1)
+	C--;
+	SetDecFlags(C);
+	END_INSTRUCTION;
+INSTRUCTION(0x0e, 2)
+	C = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x0f, 1)
+	ResolveFlags();
+	A = (A >> 1) | (A << 7);
+	fCarry = A >> 7;
+	fZero = 0;
+	fSub = 0;
+	fHalfCarry = 0;
+	END_INSTRUCTION;
+INSTRUCTION(0x10, 2)
+	Write8(0xff04, 0);
+	END_INSTRUCTION;
+INSTRUCTION(0x11, 3)
+	DE = attr16;
+	END_INSTRUCTION;
+INSTRUCTION(0x12, 1)
+	Write8(DE, A);
+	END_INSTRUCTION;
+INSTRUCTION(0x13, 1)
+	DE++;
+	END_INSTRUCTION;
+INSTRUCTION(0x14, 1)
+	D++;
+	SetIncFlags(D);
+	END_INSTRUCTION;
+INSTRUCTION(0x15, 1)
+	D--;
+	SetDecFlags(D);
+	END_INSTRUCTION;
+INSTRUCTION(0x16, 2)
+	D = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x17, 1)
+	ResolveFlags();
+	temp = A >> 7;
+	A = (A << 1) | fCarry;
+	fZero = 0;
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = temp;
+	END_INSTRUCTION;
+INSTRUCTION(0x18, 2)
+	CheckIdleLoop(PC + (int8_t)attr8);
+	PC += (int8_t)attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x19, 1)
+	ResolveFlags();
+	result = HL + DE;
+	fSub = 0;
+	fHalfCarry = ((HL & 0x0fff) + (DE & 0x0fff)) > 0x0fff;
+	fCarry = result > 0xffff;
+	HL = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x1a, 1)
+	A = Read8(DE);
+	END_INSTRUCTION;
+INSTRUCTION(0x1b, 1)
+	DE--;
+	END_INSTRUCTION;
+INSTRUCTION(0x1c, 1)
+	E++;
+	SetIncFlags(E);
+	END_INSTRUCTION;
+INSTRUCTION(0x1d, 1)
+	E--;
+	SetDecFlags(E);
+	END_INSTRUCTION;
+INSTRUCTION(0x1e, 2)
+	E = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x1f, 1)
+	ResolveFlags();
+	temp = A & 0b1;
+	A = (A >> 1) | (fCarry << 7);
+	fZero = 0;
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = temp;
+	END_INSTRUCTION;
+INSTRUCTION(0x20, 2)
+	if (!ZeroFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(PC + (int8_t)attr8);
+		PC += (int8_t)attr8;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0x21, 3)
+	HL = attr16;
+	END_INSTRUCTION;
+INSTRUCTION(0x22, 1)
+	Write8(HL, A);
+	HL++;
+	END_INSTRUCTION;
+INSTRUCTION(0x23, 1)
+	HL++;
+	END_INSTRUCTION;
+INSTRUCTION(0x24, 1)
+	H++;
+	SetIncFlags(H);
+	END_INSTRUCTION;
+INSTRUCTION(0x25, 1)
+	H--;
+	SetDecFlags(H);
+	END_INSTRUCTION;
+INSTRUCTION(0x26, 2)
+	H = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x27, 1)
+	ResolveFlags();
+	if (!fSub) {
+		if (fCarry || A > 0x99) { A += 0x60; fCarry = 1; }
+		if (fHalfCarry || (A & 0x0f) > 0x09) { A += 0x6; }
+	}
+	else {
+		if (fCarry) { A -= 0x60; }
+		if (fHalfCarry) { A -= 0x6; }
+	}
+	fZero = (A == 0);
+	fHalfCarry = 0;
+	END_INSTRUCTION;
+INSTRUCTION(0x28, 2)
+	if (ZeroFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(PC + (int8_t)attr8);
+		PC += (int8_t)attr8;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0x29, 1)
+	ResolveFlags();
+	result = HL + HL;
+	fSub = 0;
+	fHalfCarry = ((HL & 0x0fff) + (HL & 0x0fff)) > 0x0fff;
+	fCarry = result > 0xffff;
+	HL = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x2a, 1)
+	A = Read8(HL);
+	HL++;
+	END_INSTRUCTION;
+INSTRUCTION(0x2b, 1)
+	HL--;
+	END_INSTRUCTION;
+INSTRUCTION(0x2c, 1)
+	L++;
+	SetIncFlags(L);
+	END_INSTRUCTION;
+INSTRUCTION(0x2d, 1)
+	L--;
+	SetDecFlags(L);
+	END_INSTRUCTION;
+INSTRUCTION(0x2e, 2)
+	L = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x2f, 1)
+	ResolveFlags();
+	A = ~A;
+	fSub = 1;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+INSTRUCTION(0x30, 2)
+	if (!CarryFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(PC + (int8_t)attr8);
+		PC += (int8_t)attr8;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0x31, 3)
+	SP = attr16;
+	END_INSTRUCTION;
+INSTRUCTION(0x32, 1)
+	Write8(HL, A);
+	HL--;
+	END_INSTRUCTION;
+INSTRUCTION(0x33, 1)
+	SP++;
+	END_INSTRUCTION;
+INSTRUCTION(0x34, 1)
+	temp = Read8(HL);
+	result = (temp + 1) & 0xff;
+	Write8(HL, result);
+	SetIncFlags(result);
+	END_INSTRUCTION;
+INSTRUCTION(0x35, 1)
+	temp = Read8(HL);
+	result = (temp - 1) & 0xff;
+	Write8(HL, result);
+	SetDecFlags(result);
+	END_INSTRUCTION;
+INSTRUCTION(0x36, 2)
+	Write8(HL, attr8);
+	END_INSTRUCTION;
+INSTRUCTION(0x37, 1)
+	ResolveFlags();
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 1;
+	END_INSTRUCTION;
+INSTRUCTION(0x38, 2)
+	if (CarryFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(PC + (int8_t)attr8);
+		PC += (int8_t)attr8;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0x39, 1)
+	ResolveFlags();
+	result = HL + SP;
+	fSub = 0;
+	fHalfCarry = ((HL & 0x0fff) + (SP & 0x0fff)) > 0x0fff;
+	fCarry = result > 0xffff;
+	HL = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x3a, 1)
+	A = Read8(HL);
+	HL--;
+	END_INSTRUCTION;
+INSTRUCTION(0x3b, 1)
+	SP--;
+	END_INSTRUCTION;
+INSTRUCTION(0x3c, 1)
+	A++;
+	SetIncFlags(A);
+	END_INSTRUCTION;
+INSTRUCTION(0x3d, 1)
+	A--;
+	SetDecFlags(A);
+	END_INSTRUCTION;
+INSTRUCTION(0x3e, 2)
+	A = attr8;
+	END_INSTRUCTION;
+INSTRUCTION(0x3f, 1)
+	ResolveFlags();
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = !fCarry;
+	END_INSTRUCTION;
+INSTRUCTION(0x40, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x41, 1)
+	B = C;
+	END_INSTRUCTION;
+INSTRUCTION(0x42, 1)
+	B = D;
+	END_INSTRUCTION;
+INSTRUCTION(0x43, 1)
+	B = E;
+	END_INSTRUCTION;
+INSTRUCTION(0x44, 1)
+	B = H;
+	END_INSTRUCTION;
+INSTRUCTION(0x45, 1)
+	B = L;
+	END_INSTRUCTION;
+INSTRUCTION(0x46, 1)
+	B = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x47, 1)
+	B = A;
+	END_INSTRUCTION;
+INSTRUCTION(0x48, 1)
+	C = B;
+	END_INSTRUCTION;
+INSTRUCTION(0x49, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x4a, 1)
+	C = D;
+	END_INSTRUCTION;
+INSTRUCTION(0x4b, 1)
+	C = E;
+	END_INSTRUCTION;
+INSTRUCTION(0x4c, 1)
+	C = H;
+	END_INSTRUCTION;
+INSTRUCTION(0x4d, 1)
+	C = L;
+	END_INSTRUCTION;
+INSTRUCTION(0x4e, 1)
+	C = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x4f, 1)
+	C = A;
+	END_INSTRUCTION;
+INSTRUCTION(0x50, 1)
+	D = B;
+	END_INSTRUCTION;
+INSTRUCTION(0x51, 1)
+	D = C;
+	END_INSTRUCTION;
+INSTRUCTION(0x52, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x53, 1)
+	D = E;
+	END_INSTRUCTION;
+INSTRUCTION(0x54, 1)
+	D = H;
+	END_INSTRUCTION;
+INSTRUCTION(0x55, 1)
+	D = L;
+	END_INSTRUCTION;
+INSTRUCTION(0x56, 1)
+	D = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x57, 1)
+	D = A;
+	END_INSTRUCTION;
+INSTRUCTION(0x58, 1)
+	E = B;
+	END_INSTRUCTION;
+INSTRUCTION(0x59, 1)
+	E = C;
+	END_INSTRUCTION;
+INSTRUCTION(0x5a, 1)
+	E = D;
+	END_INSTRUCTION;
+INSTRUCTION(0x5b, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x5c, 1)
+	E = H;
+	END_INSTRUCTION;
+INSTRUCTION(0x5d, 1)
+	E = L;
+	END_INSTRUCTION;
+INSTRUCTION(0x5e, 1)
+	E = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x5f, 1)
+	E = A;
+	END_INSTRUCTION;
+INSTRUCTION(0x60, 1)
+	H = B;
+	END_INSTRUCTION;
+INSTRUCTION(0x61, 1)
+	H = C;
+	END_INSTRUCTION;
+INSTRUCTION(0x62, 1)
+	H = D;
+	END_INSTRUCTION;
+INSTRUCTION(0x63, 1)
+	H = E;
+	END_INSTRUCTION;
+INSTRUCTION(0x64, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x65, 1)
+	H = L;
+	END_INSTRUCTION;
+INSTRUCTION(0x66, 1)
+	H = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x67, 1)
+	H = A;
+	END_INSTRUCTION;
+INSTRUCTION(0x68, 1)
+	L = B;
+	END_INSTRUCTION;
+INSTRUCTION(0x69, 1)
+	L = C;
+	END_INSTRUCTION;
+INSTRUCTION(0x6a, 1)
+	L = D;
+	END_INSTRUCTION;
+INSTRUCTION(0x6b, 1)
+	L = E;
+	END_INSTRUCTION;
+INSTRUCTION(0x6c, 1)
+	L = H;
+	END_INSTRUCTION;
+INSTRUCTION(0x6d, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x6e, 1)
+	L = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x6f, 1)
+	L = A;
+	END_INSTRUCTION;
+INSTRUCTION(0x70, 1)
+	Write8(HL, B);
+	END_INSTRUCTION;
+INSTRUCTION(0x71, 1)
+	Write8(HL, C);
+	END_INSTRUCTION;
+INSTRUCTION(0x72, 1)
+	Write8(HL, D);
+	END_INSTRUCTION;
+INSTRUCTION(0x73, 1)
+	Write8(HL, E);
+	END_INSTRUCTION;
+INSTRUCTION(0x74, 1)
+	Write8(HL, H);
+	END_INSTRUCTION;
+INSTRUCTION(0x75, 1)
+	Write8(HL, L);
+	END_INSTRUCTION;
+INSTRUCTION(0x76, 1)
+	if (IME || (IE & IF & 0x1f) == 0) {
+		isHalting = true;
+	}
+	else {
+		haltBug = true;
+	}
+	stepClock += 4;
+	END_INSTRUCTION;
+INSTRUCTION(0x77, 1)
+	Write8(HL, A);
+	END_INSTRUCTION;
+INSTRUCTION(0x78, 1)
+	A = B;
+	END_INSTRUCTION;
+INSTRUCTION(0x79, 1)
+	A = C;
+	END_INSTRUCTION;
+INSTRUCTION(0x7a, 1)
+	A = D;
+	END_INSTRUCTION;
+INSTRUCTION(0x7b, 1)
+	A = E;
+	END_INSTRUCTION;
+INSTRUCTION(0x7c, 1)
+	A = H;
+	END_INSTRUCTION;
+INSTRUCTION(0x7d, 1)
+	A = L;
+	END_INSTRUCTION;
+INSTRUCTION(0x7e, 1)
+	A = Read8(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0x7f, 1)
+	END_INSTRUCTION;
+INSTRUCTION(0x80, 1)
+	result = A + B;
+	SetAddFlags(A, B, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x81, 1)
+	result = A + C;
+	SetAddFlags(A, C, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x82, 1)
+	result = A + D;
+	SetAddFlags(A, D, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x83, 1)
+	result = A + E;
+	SetAddFlags(A, E, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x84, 1)
+	result = A + H;
+	SetAddFlags(A, H, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x85, 1)
+	result = A + L;
+	SetAddFlags(A, L, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x86, 1)
+	temp = Read8(HL);
+	result = A + temp;
+	SetAddFlags(A, temp, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x87, 1)
+	result = A + A;
+	SetAddFlags(A, A, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x88, 1)
+	carry = CarryFlag();
+	result = A + B + carry;
+	SetAddFlags(A, B, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x89, 1)
+	carry = CarryFlag();
+	result = A + C + carry;
+	SetAddFlags(A, C, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x8a, 1)
+	carry = CarryFlag();
+	result = A + D + carry;
+	SetAddFlags(A, D, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x8b, 1)
+	carry = CarryFlag();
+	result = A + E + carry;
+	SetAddFlags(A, E, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x8c, 1)
+	carry = CarryFlag();
+	result = A + H + carry;
+	SetAddFlags(A, H, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x8d, 1)
+	carry = CarryFlag();
+	result = A + L + carry;
+	SetAddFlags(A, L, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x8e, 1)
+	temp = Read8(HL);
+	carry = CarryFlag();
+	result = A + temp + carry;
+	SetAddFlags(A, temp, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x8f, 1)
+	carry = CarryFlag();
+	result = A + A + carry;
+	SetAddFlags(A, A, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x90, 1)
+	result = A - B;
+	SetSubFlags(A, B, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x91, 1)
+	result = A - C;
+	SetSubFlags(A, C, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x92, 1)
+	result = A - D;
+	SetSubFlags(A, D, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x93, 1)
+	result = A - E;
+	SetSubFlags(A, E, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x94, 1)
+	result = A - H;
+	SetSubFlags(A, H, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x95, 1)
+	result = A - L;
+	SetSubFlags(A, L, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x96, 1)
+	temp = Read8(HL);
+	result = A - temp;
+	SetSubFlags(A, temp, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x97, 1)
+	SetSubFlags(A, A, 0, 0);
+	A = 0;
+	END_INSTRUCTION;
+INSTRUCTION(0x98, 1)
+	carry = CarryFlag();
+	result = A - B - carry;
+	SetSubFlags(A, B, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x99, 1)
+	carry = CarryFlag();
+	result = A - C - carry;
+	SetSubFlags(A, C, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x9a, 1)
+	carry = CarryFlag();
+	result = A - D - carry;
+	SetSubFlags(A, D, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x9b, 1)
+	carry = CarryFlag();
+	result = A - E - carry;
+	SetSubFlags(A, E, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x9c, 1)
+	carry = CarryFlag();
+	result = A - H - carry;
+	SetSubFlags(A, H, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x9d, 1)
+	carry = CarryFlag();
+	result = A - L - carry;
+	SetSubFlags(A, L, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x9e, 1)
+	temp = Read8(HL);
+	carry = CarryFlag();
+	result = A - temp - carry;
+	SetSubFlags(A, temp, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0x9f, 1)
+	carry = CarryFlag();
+	result = A - A - carry;
+	SetSubFlags(A, A, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xa0, 1)
+	A &= B;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa1, 1)
+	A &= C;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa2, 1)
+	A &= D;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa3, 1)
+	A &= E;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa4, 1)
+	A &= H;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa5, 1)
+	A &= L;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa6, 1)
+	A &= Read8(HL);
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa7, 1)
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xa8, 1)
+	A ^= B;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xa9, 1)
+	A ^= C;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xaa, 1)
+	A ^= D;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xab, 1)
+	A ^= E;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xac, 1)
+	A ^= H;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xad, 1)
+	A ^= L;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xae, 1)
+	A ^= Read8(HL);
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xaf, 1)
+	A = 0;
+	SetLogicFlags(0, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb0, 1)
+	A |= B;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb1, 1)
+	A |= C;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb2, 1)
+	A |= D;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb3, 1)
+	A |= E;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb4, 1)
+	A |= H;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb5, 1)
+	A |= L;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb6, 1)
+	A |= Read8(HL);
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb7, 1)
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xb8, 1)
+	SetSubFlags(A, B, 0, A - B);
+	END_INSTRUCTION;
+INSTRUCTION(0xb9, 1)
+	SetSubFlags(A, C, 0, A - C);
+	END_INSTRUCTION;
+INSTRUCTION(0xba, 1)
+	SetSubFlags(A, D, 0, A - D);
+	END_INSTRUCTION;
+INSTRUCTION(0xbb, 1)
+	SetSubFlags(A, E, 0, A - E);
+	END_INSTRUCTION;
+INSTRUCTION(0xbc, 1)
+	SetSubFlags(A, H, 0, A - H);
+	END_INSTRUCTION;
+INSTRUCTION(0xbd, 1)
+	SetSubFlags(A, L, 0, A - L);
+	END_INSTRUCTION;
+INSTRUCTION(0xbe, 1)
+	temp = Read8(HL);
+	SetSubFlags(A, temp, 0, A - temp);
+	END_INSTRUCTION;
+INSTRUCTION(0xbf, 1)
+	SetSubFlags(A, A, 0, 0);
+	END_INSTRUCTION;
+INSTRUCTION(0xc0, 1)
+	if (!ZeroFlag()) {
+		PC = Pop16();
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xc1, 1)
+	BC = Pop16();
+	END_INSTRUCTION;
+INSTRUCTION(0xc2, 3)
+	if (!ZeroFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(attr16);
+		PC = attr16;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xc3, 3)
+	CheckIdleLoop(attr16);
+	PC = attr16;
+	END_INSTRUCTION;
+INSTRUCTION(0xc4, 3)
+	if (!ZeroFlag()) {
+		Push16(PC);
+		PC = attr16;
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xc5, 1)
+	Push16(BC);
+	END_INSTRUCTION;
+INSTRUCTION(0xc6, 2)
+	result = A + attr8;
+	SetAddFlags(A, attr8, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xc7, 1)
+	Push16(PC);
+	PC = 0x00;
+	END_INSTRUCTION;
+INSTRUCTION(0xc8, 1)
+	if (ZeroFlag()) {
+		PC = Pop16();
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xc9, 1)
+	PC = Pop16();
+	END_INSTRUCTION;
+INSTRUCTION(0xca, 3)
+	if (ZeroFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(attr16);
+		PC = attr16;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xcb, 1)
+	secondaryOpcode = Read8(PC);
+	PC++;
+	stepClock += prefixOpcodeTimingTable[secondaryOpcode] * 4;
+	EXECUTE_PREFIX();
+	END_INSTRUCTION;
+INSTRUCTION(0xcc, 3)
+	if (ZeroFlag()) {
+		Push16(PC);
+		PC = attr16;
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xcd, 3)
+	Push16(PC);
+	PC = attr16;
+	END_INSTRUCTION;
+INSTRUCTION(0xce, 2)
+	carry = CarryFlag();
+	result = A + attr8 + carry;
+	SetAddFlags(A, attr8, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xcf, 1)
+	Push16(PC);
+	PC = 0x08;
+	END_INSTRUCTION;
+INSTRUCTION(0xd0, 1)
+	if (!CarryFlag()) {
+		PC = Pop16();
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xd1, 1)
+	DE = Pop16();
+	END_INSTRUCTION;
+INSTRUCTION(0xd2, 3)
+	if (!CarryFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(attr16);
+		PC = attr16;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xd4, 3)
+	if (!CarryFlag()) {
+		Push16(PC);
+		PC = attr16;
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xd5, 1)
+	Push16(DE);
+	END_INSTRUCTION;
+INSTRUCTION(0xd6, 2)
+	result = A - attr8;
+	SetSubFlags(A, attr8, 0, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xd7, 1)
+	Push16(PC);
+	PC = 0x10;
+	END_INSTRUCTION;
+INSTRUCTION(0xd8, 1)
+	if (CarryFlag()) {
+		PC = Pop16();
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xd9, 1)
+	PC = Pop16();
+	IME = 1;
+	END_INSTRUCTION;
+INSTRUCTION(0xda, 3)
+	if (CarryFlag()) {
+		stepClock += 4;
+		CheckIdleLoop(attr16);
+		PC = attr16;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xdc, 3)
+	if (CarryFlag()) {
+		Push16(PC);
+		PC = attr16;
+		stepClock += 12;
+	}
+	END_INSTRUCTION;
+INSTRUCTION(0xde, 2)
+	carry = CarryFlag();
+	result = A - attr8 - carry;
+	SetSubFlags(A, attr8, carry, result);
+	A = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xdf, 1)
+	Push16(PC);
+	PC = 0x18;
+	END_INSTRUCTION;
+INSTRUCTION(0xe0, 2)
+	Write8(0xff00 | attr8, A);
+	END_INSTRUCTION;
+INSTRUCTION(0xe1, 1)
+	HL = Pop16();
+	END_INSTRUCTION;
+INSTRUCTION(0xe2, 1)
+	Write8(0xff00 | C, A);
+	END_INSTRUCTION;
+INSTRUCTION(0xe5, 1)
+	Push16(HL);
+	END_INSTRUCTION;
+INSTRUCTION(0xe6, 2)
+	A &= attr8;
+	SetLogicFlags(A, true);
+	END_INSTRUCTION;
+INSTRUCTION(0xe7, 1)
+	Push16(PC);
+	PC = 0x20;
+	END_INSTRUCTION;
+INSTRUCTION(0xe8, 2)
+	ResolveFlags();
+	result = SP + (int8_t)attr8;
+	fHalfCarry = ((SP ^ attr8 ^ result) & 0x10) == 0x10;
+	fCarry = ((SP ^ (int16_t)((int8_t)attr8) ^ result) & 0x100) == 0x100;
+	fZero = 0;
+	fSub = 0;
+	SP = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xe9, 1)
+	PC = HL;
+	END_INSTRUCTION;
+INSTRUCTION(0xea, 3)
+	Write8(attr16, A);
+	END_INSTRUCTION;
+INSTRUCTION(0xee, 2)
+	A ^= attr8;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xef, 1)
+	Push16(PC);
+	PC = 0x28;
+	END_INSTRUCTION;
+INSTRUCTION(0xf0, 2)
+	A = Read8(0xff00 | attr8);
+	END_INSTRUCTION;
+INSTRUCTION(0xf1, 1)
+	ResolveFlags();
+	AF = Pop16() & 0xfff0;
+	END_INSTRUCTION;
+INSTRUCTION(0xf2, 1)
+	A = Read8(0xff00 | C);
+	END_INSTRUCTION;
+INSTRUCTION(0xf3, 1)
+	IME = 0;
+	END_INSTRUCTION;
+INSTRUCTION(0xf5, 1)
+	ResolveFlags();
+	Push16(AF & 0xfff0);
+	END_INSTRUCTION;
+INSTRUCTION(0xf6, 2)
+	A |= attr8;
+	SetLogicFlags(A, false);
+	END_INSTRUCTION;
+INSTRUCTION(0xf7, 1)
+	Push16(PC);
+	PC = 0x30;
+	END_INSTRUCTION;
+INSTRUCTION(0xf8, 2)
+	ResolveFlags();
+	result = SP + (int8_t)attr8;
+	fZero = 0;
+	fSub = 0;
+	fHalfCarry = ((SP ^ attr8 ^ result) & 0x10) == 0x10;
+	fCarry = ((SP ^ (int16_t)((int8_t)attr8) ^ result) & 0x100) == 0x100;
+	HL = result;
+	END_INSTRUCTION;
+INSTRUCTION(0xf9, 1)
+	SP = HL;
+	END_INSTRUCTION;
+INSTRUCTION(0xfa, 3)
+	A = Read8(attr16);
+	END_INSTRUCTION;
+INSTRUCTION(0xfb, 1)
+	//stepClock += Step();
+	//if (opcode != 0xf3) {
+		IME = 1;
+	//}
+	END_INSTRUCTION;
+INSTRUCTION(0xfe, 2)
+	SetSubFlags(A, attr8, 0, A - attr8);
+	END_INSTRUCTION;
+INSTRUCTION(0xff, 1)
+	Push16(PC);
+	PC = 0x38;
+	END_INSTRUCTION;
@@ -0,0 +1,1362 @@
+// CB-prefixed SM83 instruction bodies shared by the CPU dispatch cores. The
+// includer defines PREFIX_INSTRUCTION(code) and END_INSTRUCTION.
+PREFIX_INSTRUCTION(0x00)
+	ResolveFlags();
+	carry = B >> 7;
+	B = (B << 1) | carry;
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x01)
+	ResolveFlags();
+	carry = C >> 7;
+	C = (C << 1) | carry;
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x02)
+	ResolveFlags();
+	carry = D >> 7;
+	D = (D << 1) | carry;
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x03)
+	ResolveFlags();
+	carry = E >> 7;
+	E = (E << 1) | carry;
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x04)
+	ResolveFlags();
+	carry = H >> 7;
+	H = (H << 1) | carry;
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x05)
+	ResolveFlags();
+	carry = L >> 7;
+	L = (L << 1) | carry;
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x06)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp >> 7;
+	temp = (temp << 1) | carry;
+	Write8(HL, temp);
+	fZero = (temp == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x07)
+	ResolveFlags();
+	carry = A >> 7;
+	A = (A << 1) | carry;
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x08)
+	ResolveFlags();
+	carry = B & 0b1;
+	B = (B >> 1) | (carry << 7);
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x09)
+	ResolveFlags();
+	carry = C & 0b1;
+	C = (C >> 1) | (carry << 7);
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x0a)
+	ResolveFlags();
+	carry = D & 0b1;
+	D = (D >> 1) | (carry << 7);
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x0b)
+	ResolveFlags();
+	carry = E & 0b1;
+	E = (E >> 1) | (carry << 7);
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x0c)
+	ResolveFlags();
+	carry = H & 0b1;
+	H = (H >> 1) | (carry << 7);
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x0d)
+	ResolveFlags();
+	carry = L & 0b1;
+	L = (L >> 1) | (carry << 7);
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x0e)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp & 0b1;
+	temp = (temp >> 1) | (carry << 7);
+	Write8(HL, temp);
+	fZero = (temp == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x0f)
+	ResolveFlags();
+	carry = A & 0b1;
+	A = (A >> 1) | (carry << 7);
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x10)
+	ResolveFlags();
+	carry = B >> 7;
+	B = (B << 1) | fCarry;
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x11)
+	ResolveFlags();
+	carry = C >> 7;
+	C = (C << 1) | fCarry;
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x12)
+	ResolveFlags();
+	carry = D >> 7;
+	D = (D << 1) | fCarry;
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x13)
+	ResolveFlags();
+	carry = E >> 7;
+	E = (E << 1) | fCarry;
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x14)
+	ResolveFlags();
+	carry = H >> 7;
+	H = (H << 1) | fCarry;
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x15)
+	ResolveFlags();
+	carry = L >> 7;
+	L = (L << 1) | fCarry;
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x16)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp >> 7;
+	temp = (temp << 1) | fCarry;
+	Write8(HL, temp);
+	fZero = ((temp & 0xff) == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x17)
+	ResolveFlags();
+	carry = A >> 7;
+	A = (A << 1) | fCarry;
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x18)
+	ResolveFlags();
+	carry = B & 0b1;
+	B = (B >> 1) | (fCarry << 7);
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x19)
+	ResolveFlags();
+	carry = C & 0b1;
+	C = (C >> 1) | (fCarry << 7);
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x1a)
+	ResolveFlags();
+	carry = D & 0b1;
+	D = (D >> 1) | (fCarry << 7);
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x1b)
+	ResolveFlags();
+	carry = E & 0b1;
+	E = (E >> 1) | (fCarry << 7);
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x1c)
+	ResolveFlags();
+	carry = H & 0b1;
+	H = (H >> 1) | (fCarry << 7);
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x1d)
+	ResolveFlags();
+	carry = L & 0b1;
+	L = (L >> 1) | (fCarry << 7);
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x1e)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp & 0b1;
+	temp = (temp >> 1) | (fCarry << 7);
+	fZero = (temp == 0);
+	Write8(HL, temp);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x1f)
+	ResolveFlags();
+	carry = A & 0b1;
+	A = (A >> 1) | (fCarry << 7);
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x20)
+	ResolveFlags();
+	carry = B >> 7;
+	B = (B << 1);
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x21)
+	ResolveFlags();
+	carry = C >> 7;
+	C = (C << 1);
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x22)
+	ResolveFlags();
+	carry = D >> 7;
+	D = (D << 1);
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x23)
+	ResolveFlags();
+	carry = E >> 7;
+	E = (E << 1);
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x24)
+	ResolveFlags();
+	carry = H >> 7;
+	H = (H << 1);
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x25)
+	ResolveFlags();
+	carry = L >> 7;
+	L = (L << 1);
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x26)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp >> 7;
+	temp = (temp << 1);
+	Write8(HL, temp);
+	fZero = ((temp & 0xff) == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x27)
+	ResolveFlags();
+	carry = A >> 7;
+	A = (A << 1);
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x28)
+	ResolveFlags();
+	carry = B & 0b1;
+	sign = B & (0b1 << 7);
+	B = (B >> 1) | sign;
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x29)
+	ResolveFlags();
+	carry = C & 0b1;
+	sign = C & (0b1 << 7);
+	C = (C >> 1) | sign;
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x2a)
+	ResolveFlags();
+	carry = D & 0b1;
+	sign = D & (0b1 << 7);
+	D = (D >> 1) | sign;
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x2b)
+	ResolveFlags();
+	carry = E & 0b1;
+	sign = E & (0b1 << 7);
+	E = (E >> 1) | sign;
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x2c)
+	ResolveFlags();
+	carry = H & 0b1;
+	sign = H & (0b1 << 7);
+	H = (H >> 1) | sign;
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x2d)
+	ResolveFlags();
+	carry = L & 0b1;
+	sign = L & (0b1 << 7);
+	L = (L >> 1) | sign;
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x2e)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp & 0b1;
+	sign = temp & (0b1 << 7);
+	temp = (temp >> 1) | sign;
+	Write8(HL, temp);
+	fZero = (temp == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x2f)
+	ResolveFlags();
+	carry = A & 0b1;
+	sign = A & (0b1 << 7);
+	A = (A >> 1) | sign;
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x30)
+	ResolveFlags();
+	B = (B >> 4) | ((B << 4) & 0xf0);
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x31)
+	ResolveFlags();
+	C = (C >> 4) | ((C << 4) & 0xf0);
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x32)
+	ResolveFlags();
+	D = (D >> 4) | ((D << 4) & 0xf0);
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x33)
+	ResolveFlags();
+	E = (E >> 4) | ((E << 4) & 0xf0);
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x34)
+	ResolveFlags();
+	H = (H >> 4) | ((H << 4) & 0xf0);
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x35)
+	ResolveFlags();
+	L = (L >> 4) | ((L << 4) & 0xf0);
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x36)
+	ResolveFlags();
+	temp = Read8(HL);
+	temp = (temp >> 4) | ((temp << 4) & 0xf0);
+	Write8(HL, temp);
+	fZero = (temp == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x37)
+	ResolveFlags();
+	A = (A >> 4) | ((A << 4) & 0xf0);
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = 0;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x38)
+	ResolveFlags();
+	carry = B & 0b1;
+	B = (B >> 1);
+	fZero = (B == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x39)
+	ResolveFlags();
+	carry = C & 0b1;
+	C = (C >> 1);
+	fZero = (C == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x3a)
+	ResolveFlags();
+	carry = D & 0b1;
+	D = (D >> 1);
+	fZero = (D == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x3b)
+	ResolveFlags();
+	carry = E & 0b1;
+	E = (E >> 1);
+	fZero = (E == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x3c)
+	ResolveFlags();
+	carry = H & 0b1;
+	H = (H >> 1);
+	fZero = (H == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x3d)
+	ResolveFlags();
+	carry = L & 0b1;
+	L = (L >> 1);
+	fZero = (L == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x3e)
+	ResolveFlags();
+	temp = Read8(HL);
+	carry = temp & 0b1;
+	temp = (temp >> 1);
+	Write8(HL, temp);
+	fZero = (temp == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x3f)
+	ResolveFlags();
+	carry = A & 0b1;
+	A = (A >> 1);
+	fZero = (A == 0);
+	fSub = 0;
+	fHalfCarry = 0;
+	fCarry = carry;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x40)
+	ResolveFlags();
+	fZero = ((B >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x41)
+	ResolveFlags();
+	fZero = ((C >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x42)
+	ResolveFlags();
+	fZero = ((D >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x43)
+	ResolveFlags();
+	fZero = ((E >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x44)
+	ResolveFlags();
+	fZero = ((H >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x45)
+	ResolveFlags();
+	fZero = ((L >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x46)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x47)
+	ResolveFlags();
+	fZero = ((A >> 0) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x48)
+	ResolveFlags();
+	fZero = ((B >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x49)
+	ResolveFlags();
+	fZero = ((C >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x4a)
+	ResolveFlags();
+	fZero = ((D >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x4b)
+	ResolveFlags();
+	fZero = ((E >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x4c)
+	ResolveFlags();
+	fZero = ((H >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x4d)
+	ResolveFlags();
+	fZero = ((L >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x4e)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x4f)
+	ResolveFlags();
+	fZero = ((A >> 1) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x50)
+	ResolveFlags();
+	fZero = ((B >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x51)
+	ResolveFlags();
+	fZero = ((C >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x52)
+	ResolveFlags();
+	fZero = ((D >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x53)
+	ResolveFlags();
+	fZero = ((E >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x54)
+	ResolveFlags();
+	fZero = ((H >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x55)
+	ResolveFlags();
+	fZero = ((L >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x56)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x57)
+	ResolveFlags();
+	fZero = ((A >> 2) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x58)
+	ResolveFlags();
+	fZero = ((B >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x59)
+	ResolveFlags();
+	fZero = ((C >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x5a)
+	ResolveFlags();
+	fZero = ((D >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x5b)
+	ResolveFlags();
+	fZero = ((E >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x5c)
+	ResolveFlags();
+	fZero = ((H >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x5d)
+	ResolveFlags();
+	fZero = ((L >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x5e)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x5f)
+	ResolveFlags();
+	fZero = ((A >> 3) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x60)
+	ResolveFlags();
+	fZero = ((B >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x61)
+	ResolveFlags();
+	fZero = ((C >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x62)
+	ResolveFlags();
+	fZero = ((D >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x63)
+	ResolveFlags();
+	fZero = ((E >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x64)
+	ResolveFlags();
+	fZero = ((H >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x65)
+	ResolveFlags();
+	fZero = ((L >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x66)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x67)
+	ResolveFlags();
+	fZero = ((A >> 4) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x68)
+	ResolveFlags();
+	fZero = ((B >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x69)
+	ResolveFlags();
+	fZero = ((C >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x6a)
+	ResolveFlags();
+	fZero = ((D >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x6b)
+	ResolveFlags();
+	fZero = ((E >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x6c)
+	ResolveFlags();
+	fZero = ((H >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x6d)
+	ResolveFlags();
+	fZero = ((L >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x6e)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x6f)
+	ResolveFlags();
+	fZero = ((A >> 5) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x70)
+	ResolveFlags();
+	fZero = ((B >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x71)
+	ResolveFlags();
+	fZero = ((C >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x72)
+	ResolveFlags();
+	fZero = ((D >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x73)
+	ResolveFlags();
+	fZero = ((E >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x74)
+	ResolveFlags();
+	fZero = ((H >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x75)
+	ResolveFlags();
+	fZero = ((L >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x76)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x77)
+	ResolveFlags();
+	fZero = ((A >> 6) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x78)
+	ResolveFlags();
+	fZero = ((B >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x79)
+	ResolveFlags();
+	fZero = ((C >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x7a)
+	ResolveFlags();
+	fZero = ((D >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x7b)
+	ResolveFlags();
+	fZero = ((E >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x7c)
+	ResolveFlags();
+	fZero = ((H >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x7d)
+	ResolveFlags();
+	fZero = ((L >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x7e)
+	ResolveFlags();
+	fZero = ((Read8(HL) >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x7f)
+	ResolveFlags();
+	fZero = ((A >> 7) & 0b1) == 0;
+	fSub = 0;
+	fHalfCarry = 1;
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x80)
+	B &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x81)
+	C &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x82)
+	D &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x83)
+	E &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x84)
+	H &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x85)
+	L &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x86)
+	Write8(HL, Read8(HL) & ~(1 << 0));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x87)
+	A &= ~(1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x88)
+	B &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x89)
+	C &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x8a)
+	D &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x8b)
+	E &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x8c)
+	H &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x8d)
+	L &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x8e)
+	Write8(HL, Read8(HL) & ~(1 << 1));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x8f)
+	A &= ~(1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x90)
+	B &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x91)
+	C &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x92)
+	D &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x93)
+	E &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x94)
+	H &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x95)
+	L &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x96)
+	Write8(HL, Read8(HL) & ~(1 << 2));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x97)
+	A &= ~(1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x98)
+	B &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x99)
+	C &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x9a)
+	D &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x9b)
+	E &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x9c)
+	H &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x9d)
+	L &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x9e)
+	Write8(HL, Read8(HL) & ~(1 << 3));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0x9f)
+	A &= ~(1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa0)
+	B &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa1)
+	C &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa2)
+	D &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa3)
+	E &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa4)
+	H &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa5)
+	L &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa6)
+	Write8(HL, Read8(HL) & ~(1 << 4));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa7)
+	A &= ~(1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa8)
+	B &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xa9)
+	C &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xaa)
+	D &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xab)
+	E &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xac)
+	H &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xad)
+	L &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xae)
+	Write8(HL, Read8(HL) & ~(1 << 5));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xaf)
+	A &= ~(1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb0)
+	B &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb1)
+	C &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb2)
+	D &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb3)
+	E &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb4)
+	H &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb5)
+	L &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb6)
+	Write8(HL, Read8(HL) & ~(1 << 6));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb7)
+	A &= ~(1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb8)
+	B &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xb9)
+	C &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xba)
+	D &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xbb)
+	E &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xbc)
+	H &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xbd)
+	L &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xbe)
+	Write8(HL, Read8(HL) & ~(1 << 7));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xbf)
+	A &= ~(1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc0)
+	B |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc1)
+	C |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc2)
+	D |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc3)
+	E |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc4)
+	H |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc5)
+	L |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc6)
+	Write8(HL, Read8(HL) | (1 << 0));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc7)
+	A |= (1 << 0);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc8)
+	B |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xc9)
+	C |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xca)
+	D |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xcb)
+	E |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xcc)
+	H |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xcd)
+	L |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xce)
+	Write8(HL, Read8(HL) | (1 << 1));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xcf)
+	A |= (1 << 1);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd0)
+	B |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd1)
+	C |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd2)
+	D |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd3)
+	E |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd4)
+	H |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd5)
+	L |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd6)
+	Write8(HL, Read8(HL) | (1 << 2));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd7)
+	A |= (1 << 2);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd8)
+	B |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xd9)
+	C |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xda)
+	D |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xdb)
+	E |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xdc)
+	H |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xdd)
+	L |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xde)
+	Write8(HL, Read8(HL) | (1 << 3));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xdf)
+	A |= (1 << 3);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe0)
+	B |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe1)
+	C |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe2)
+	D |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe3)
+	E |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe4)
+	H |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe5)
+	L |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe6)
+	Write8(HL, Read8(HL) | (1 << 4));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe7)
+	A |= (1 << 4);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe8)
+	B |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xe9)
+	C |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xea)
+	D |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xeb)
+	E |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xec)
+	H |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xed)
+	L |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xee)
+	Write8(HL, Read8(HL) | (1 << 5));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xef)
+	A |= (1 << 5);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf0)
+	B |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf1)
+	C |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf2)
+	D |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf3)
+	E |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf4)
+	H |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf5)
+	L |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf6)
+	Write8(HL, Read8(HL) | (1 << 6));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf7)
+	A |= (1 << 6);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf8)
+	B |= (1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xf9)
+	C |= (1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xfa)
+	D |= (1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xfb)
+	E |= (1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xfc)
+	H |= (1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xfd)
+	L |= (1 << 7);
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xfe)
+	Write8(HL, Read8(HL) | (1 << 7));
+	END_INSTRUCTION;
+PREFIX_INSTRUCTION(0xff)
+	A |= (1 << 7);
+	END_INSTRUCTION;
@@ -1,4 +1,5 @@
 #include "DMA.h"
+#include <algorithm>
 
 DMA::DMA(Bus& bus) : bus(bus) {}
 
@@ -10,14 +11,37 @@ void DMA::Reset() {
 	HDMA5 = 0xff;
 	active = false;
 	writes = 0;
+	vramSource = 0;
+	vramDestination = 0;
+	vramBlocks = 0;
+	hblankActive = false;
 }
 
+// Copies every byte the transfer has reached since the last synchronization
+// in one block. The bus stays locked until the scheduled end of the transfer.
 void DMA::Step(uint32_t cpuCycles) {
 	if (!active) return;
-	for (uint32_t i = 0; i < cpuCycles && writes < 0xa0; i++, writes++) {
-		bus.Write8(0xfe00 | writes, bus.Read8((((uint16_t)OAM) << 8) | writes, true), true);
+	uint32_t count = std::min(cpuCycles, MMC::OAMSize - writes);
+	const uint8_t* source = bus.GetMappedReadPage(OAM);
+	if (source) {
+		bus.mmc->WriteOAMBlock(writes, source + writes, count);
+		writes += count;
+	}
+	else {
+		for (uint32_t end = writes + count; writes < end; writes++) {
+			bus.mmc->WriteOAM(0xfe00 | writes, bus.Read8((((uint16_t)OAM) << 8) | writes, true));
+		}
+	}
+	if (writes >= MMC::OAMSize) {
+		active = false;
+		bus.UnlockMemoryMap();
 	}
-	if (writes >= 0xa0) active = false;
+}
+
+uint32_t DMA::CyclesUntilEvent() {
+	// PPU fetches see the bus lock-out. They only happen at PPU deadlines, which
+	// synchronize DMA first, so the end of the transfer is the only event needed.
+	return active ? MMC::OAMSize - writes : 0;
 }
 
 uint8_t DMA::ReadOAM() {
@@ -48,6 +72,7 @@ void DMA::WriteOAM(uint8_t value) {
 	OAM = value % 0xe0;
 	writes = 0;
 	active = true;
+	bus.LockMemoryMap();
 }
 
 void DMA::WriteHDMA1(uint8_t value) {
@@ -66,8 +91,63 @@ void DMA::WriteHDMA4(uint8_t value) {
 	HDMA4 = value;
 }
 
+// Bit 7 clear starts a general purpose transfer, or cancels a running HBlank
+// transfer. Bit 7 set starts an HBlank transfer. The low bits are the length
+// in 16 byte blocks, minus one.
 void DMA::WriteHDMA5(uint8_t value) {
-	HDMA5 = value;
+	if (hblankActive && !(value & 0x80)) {
+		hblankActive = false;
+		HDMA5 = 0x80 | (vramBlocks - 1);
+		return;
+	}
+	vramSource = ((HDMA1 << 8) | HDMA2) & 0xfff0;
+	vramDestination = 0x8000 | (((HDMA3 << 8) | HDMA4) & 0x1ff0);
+	vramBlocks = (value & 0x7f) + 1;
+	if (value & 0x80) {
+		hblankActive = true;
+		HDMA5 = vramBlocks - 1;
+		// Started with the LCD off or inside HBlank, the first block goes right away.
+		if (!bus.ppu.LCDEnable || bus.ppu.mode == PPUMode::HBlank) TransferHBlankBlock();
+		return;
+	}
+	bus.cpu.Stall(vramBlocks * VRAMBlockCycles);
+	while (vramBlocks) {
+		CopyVRAMBlock();
+	}
+	HDMA5 = 0xff;
+}
+
+void DMA::HBlank() {
+	if (hblankActive && bus.ppu.LCDEnable) TransferHBlankBlock();
+}
+
+void DMA::TransferHBlankBlock() {
+	bus.cpu.Stall(VRAMBlockCycles);
+	CopyVRAMBlock();
+	if (vramBlocks) {
+		HDMA5 = vramBlocks - 1;
+	}
+	else {
+		hblankActive = false;
+		HDMA5 = 0xff;
+	}
+}
+
+void DMA::CopyVRAMBlock() {
+	std::array<uint8_t, VRAMBlockSize> block;
+	const uint8_t* source = bus.GetMappedReadPage(vramSource >> 8);
+	if (source) {
+		std::copy(source + (vramSource & 0xff), source + (vramSource & 0xff) + VRAMBlockSize, block.begin());
+	}
+	else {
+		for (uint32_t i = 0; i < VRAMBlockSize; i++) {
+			block[i] = bus.Read8(vramSource + i, true);
+		}
+	}
+	bus.WriteVRAMBlock(vramDestination, block.data(), VRAMBlockSize);
+	vramSource += VRAMBlockSize;
+	vramDestination = 0x8000 | ((vramDestination + VRAMBlockSize) & 0x1ff0);
+	vramBlocks--;
 }
 
 void DMA::WriteState(SaveState& state) {
@@ -77,6 +157,10 @@ void DMA::WriteState(SaveState& state) {
 	state.Write8(HDMA3);
 	state.Write8(HDMA4);
 	state.Write8(HDMA5);
+	state.Write16(vramSource);
+	state.Write16(vramDestination);
+	state.Write8(vramBlocks);
+	state.Write8(hblankActive);
 }
 
 void DMA::LoadState(SaveState& state) {
@@ -86,4 +170,8 @@ void DMA::LoadState(SaveState& state) {
 	HDMA3 = state.Read8();
 	HDMA4 = state.Read8();
 	HDMA5 = state.Read8();
+	vramSource = state.Read16();
+	vramDestination = state.Read16();
+	vramBlocks = state.Read8();
+	hblankActive = state.Read8();
 }
\ No newline at end of file
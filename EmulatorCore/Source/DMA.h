@@ -12,6 +12,7 @@ public:
 
 	void Reset();
 	void Step(uint32_t cpuCycles);
+	uint32_t CyclesUntilEvent();
 
 	uint8_t ReadOAM();
 	uint8_t ReadHDMA1();
@@ -25,6 +26,8 @@ public:
 	void WriteHDMA3(uint8_t value);
 	void WriteHDMA4(uint8_t value);
 	void WriteHDMA5(uint8_t value);
+	// Called by the PPU when a line enters HBlank.
+	void HBlank();
 
 	void WriteState(SaveState& state);
 	void LoadState(SaveState& state);
@@ -41,6 +44,18 @@ protected:
 
 	uint32_t writes = 0;
 
+	// VRAM DMA. GDMA copies every block when HDMA5 is written, HDMA one block
+	// at the start of each HBlank.
+	static const uint32_t VRAMBlockSize = 0x10;
+	static const uint32_t VRAMBlockCycles = 32;
+	uint16_t vramSource = 0;
+	uint16_t vramDestination = 0;
+	uint8_t vramBlocks = 0;
+	bool hblankActive = false;
+
+	void TransferHBlankBlock();
+	void CopyVRAMBlock();
+
 	friend class GBCEmulator;
 };
 
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Memory layout of one pixel. RGBA8 is four bytes in R, G, B, A order, RGB565 is
+// a native 16-bit word with red in the top bits and Index8 keeps the DMG shade
+// number (0-3) for hosts that apply their own palette.
+enum class PixelFormat : uint8_t {
+	RGBA8,
+	RGB565,
+	Index8,
+};
+
+// Packed pixels written by the PPU. Frames are fully redrawn, so nothing clears
+// the buffer between them.
+struct FrameBuffer {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	PixelFormat format = PixelFormat::RGBA8;
+	std::vector<uint8_t> pixels;
+
+	FrameBuffer(uint32_t _width = 0, uint32_t _height = 0, PixelFormat _format = PixelFormat::RGBA8)
+		: width(_width), height(_height), format(_format), pixels(_width * _height * BytesPerPixel(_format)) {}
+
+	static uint32_t BytesPerPixel(PixelFormat format) {
+		switch (format) {
+		case PixelFormat::RGBA8: return 4;
+		case PixelFormat::RGB565: return 2;
+		default: return 1;
+		}
+	}
+
+	// Pixel value of an 8-bit per channel color. Index8 has no colors and takes the shade instead.
+	static uint32_t Pack(PixelFormat format, uint8_t r, uint8_t g, uint8_t b, uint8_t shade = 0) {
+		switch (format) {
+		case PixelFormat::RGBA8: {
+			uint8_t bytes[4] = { r, g, b, 0xff };
+			uint32_t value;
+			memcpy(&value, bytes, sizeof(value));
+			return value;
+		}
+		case PixelFormat::RGB565:
+			return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+		default:
+			return shade;
+		}
+	}
+
+	size_t ByteSize() const {
+		return pixels.size();
+	}
+
+	void SetFormat(PixelFormat _format) {
+		format = _format;
+		pixels.assign(width * height * BytesPerPixel(format), 0);
+	}
+
+	void SetPixel(uint32_t x, uint32_t y, uint32_t value) {
+		if (x >= width || y >= height) return;
+		uint32_t pixelIndex = y * width + x;
+		switch (format) {
+		case PixelFormat::RGBA8: memcpy(&pixels[pixelIndex * 4], &value, 4); break;
+		case PixelFormat::RGB565: {
+			uint16_t packed = (uint16_t)value;
+			memcpy(&pixels[pixelIndex * 2], &packed, 2);
+			break;
+		}
+		default: pixels[pixelIndex] = (uint8_t)value; break;
+		}
+	}
+
+	uint32_t GetPixel(uint32_t x, uint32_t y) const {
+		if (x >= width || y >= height) return 0;
+		uint32_t pixelIndex = y * width + x;
+		switch (format) {
+		case PixelFormat::RGBA8: {
+			uint32_t value;
+			memcpy(&value, &pixels[pixelIndex * 4], 4);
+			return value;
+		}
+		case PixelFormat::RGB565: {
+			uint16_t packed;
+			memcpy(&packed, &pixels[pixelIndex * 2], 2);
+			return packed;
+		}
+		default: return pixels[pixelIndex];
+		}
+	}
+};
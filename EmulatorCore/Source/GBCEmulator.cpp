@@ -1,42 +1,50 @@
 #include "GBCEmulator.h"
+#include "Log.h"
 
-GBCEmulator::GBCEmulator() : mmc(new MMC(bus)), dma(bus), joypad1(bus), timer(bus), spu(bus), ppu(bus), cpu(bus),
-bus(mmc, dma, joypad1, timer, spu, ppu, cpu) {}
+GBCEmulator::GBCEmulator() : mapper(std::in_place_type<ROMOnly>, bus), dma(bus), joypad1(bus), timer(bus), spu(bus), ppu(bus), cpu(bus),
+bus(scheduler, mapper, dma, joypad1, timer, spu, ppu, cpu) {}
+
+GBCEmulator::~GBCEmulator() {
+	delete saveState;
+}
 
 void GBCEmulator::Reset() {
 	bus.Reset();
 	clockAligner = 0;
 }
 
-bool GBCEmulator::LoadROM(uint8_t* data, uint32_t romSize) {
-	delete mmc;
-	mmc = CreateMMC((MMCType)data[0x147]);
-	bus.mmc = mmc;
+bool GBCEmulator::LoadROM(std::shared_ptr<const ROMImage> image) {
+	if (!image) return false;
+	CreateMapper((MMCType)image->GetData()[0x147]);
 	Reset();
-	mmc->LoadROM(data, romSize);
+	std::visit([&image](auto& mapper) { mapper.LoadROM(image); }, mapper);
 	romLoaded = true;
 	return true;
 }
 
+bool GBCEmulator::LoadROM(const uint8_t* data, uint32_t romSize) {
+	return LoadROM(ROMImage::FromMemory(data, romSize));
+}
+
 void GBCEmulator::Run(uint32_t cpuCycles) {
 	if (!romLoaded) return;
 	clockAligner += cpuCycles;
+	bool lockstep = syncMode == SyncMode::Lockstep;
 	while (clockAligner > 0) {
-		uint32_t cycles = cpu.Step();
-		clockAligner -= cycles;
-		timer.Step(cycles);
-		dma.Step(cycles);
-		spu.Step(cycles);
-		ppu.StepScanlineMode(cycles);
+		clockAligner -= cpu.Run(lockstep ? 1 : clockAligner);
+		if (scheduler.DeadlineReached() || lockstep) {
+			bus.Synchronize();
+		}
 	}
+	bus.Synchronize();
+	spu.Synchronize();
 }
 
 void GBCEmulator::Step() {
-	uint32_t cycles = cpu.Step();
-	timer.Step(cycles);
-	dma.Step(cycles);
-	spu.Step(cycles);
-	ppu.StepScanlineMode(cycles);
+	scheduler.Advance(cpu.Step());
+	cpu.ResolveFlags();
+	bus.Synchronize();
+	spu.Synchronize();
 }
 
 bool GBCEmulator::IsFrameReady() {
@@ -47,6 +55,10 @@ void GBCEmulator::ResetFrameReadyFlag() {
 	ppu.frameReady = false;
 }
 
+void GBCEmulator::SetFrameSkip(FrameSkipMode mode, uint32_t skip, uint32_t interval) {
+	ppu.SetFrameSkip(mode, skip, interval);
+}
+
 SaveState* GBCEmulator::GetSaveState() {
 	return saveState;
 }
@@ -57,7 +69,7 @@ SaveState* GBCEmulator::CreateSaveState() {
 	cpu.WriteState(*saveState);
 	dma.WriteState(*saveState);
 	joypad1.WriteState(*saveState);
-	mmc->WriteState(*saveState);
+	std::visit([this](auto& mapper) { mapper.WriteState(*saveState); }, mapper);
 	ppu.WriteState(*saveState);
 	timer.WriteState(*saveState);
 	//spu.WriteState(*saveState);
@@ -75,30 +87,52 @@ bool GBCEmulator::LoadSaveState() {
 		cpu.LoadState(*saveState);
 		dma.LoadState(*saveState);
 		joypad1.LoadState(*saveState);
-		mmc->LoadState(*saveState);
+		std::visit([this](auto& mapper) { mapper.LoadState(*saveState); }, mapper);
 		ppu.LoadState(*saveState);
 		timer.LoadState(*saveState);
 		//spu.LoadState(*saveState);
+		bus.ScheduleEvents();
 	}
 	catch (std::exception e) {
-		std::cout << "Failed to load save state: " << e.what() << "\n";
+		CoreLog() << "Failed to load save state: " << e.what() << "\n";
 		return false;
 	}
 	return true;
 }
 
-MMC* GBCEmulator::CreateMMC(MMCType type) {
+void GBCEmulator::CreateMapper(MMCType type) {
 	switch (type) {
 	case MMCType::MBC1:
 	case MMCType::MBC1_RAM:
 	case MMCType::MBC1_RAM_BATTERY:
-		return new MBC1(bus);
+		mapper.emplace<MBC1>(bus);
+		break;
+	case MMCType::MBC3_TIMER_BATTERY:
+	case MMCType::MBC3_TIMER_RAM_BATTERY:
+	case MMCType::MBC3:
+	case MMCType::MBC3_RAM:
+	case MMCType::MBC3_RAM_BATTERY:
+		mapper.emplace<MBC3>(bus);
+		break;
+	case MMCType::MBC5:
+	case MMCType::MBC5_RAM:
+	case MMCType::MBC5_RAM_BATTERY:
+	case MMCType::MBC5_RUMBLE:
+	case MMCType::MBC5_RUMBLE_RAM:
+	case MMCType::MBC5_RUMBLE_RAM_BATTERY:
+		mapper.emplace<MBC5>(bus);
+		break;
 	default:
-		std::cout << "Unhandled Memory Controller: " << MMCTypeToString(type) << ". Default created instead.\n;";
-		return new MMC(bus);
+		CoreLog() << "Unhandled Memory Controller: " << MMCTypeToString(type) << ". Default created instead.\n;";
+		mapper.emplace<ROMOnly>(bus);
+		break;
 	case MMCType::ROM_ONLY:
-		return new MMC(bus);
+	case MMCType::ROM_RAM:
+	case MMCType::ROM_RAM_BATTERY:
+		mapper.emplace<ROMOnly>(bus);
+		break;
 	}
+	bus.mmc = GetMMC(mapper);
 }
 
 std::string GBCEmulator::GetROMName() {
@@ -9,10 +9,11 @@
 #include "DMA.h"
 #include "CPU.h"
 #include "SaveState.h"
+#include "ROMImage.h"
+#include "Scheduler.h"
 
 class Bus;
 class MMC;
-class MBC1;
 class Joypad;
 class Timer;
 class SPU;
@@ -23,14 +24,20 @@ enum class MMCType;
 
 const uint32_t saveStateSize = 0x4000;
 
+enum class SyncMode {
+	Lockstep,
+	Scheduled
+};
+
 class GBCEmulator {
 public:
 	static const uint32_t FrameCycles = 70224;
 	static const uint32_t HalfFrameCycles = FrameCycles / 2;
 	static const uint32_t QuarterFrameCycles = FrameCycles / 4;
 
+	Scheduler scheduler;
+	Mapper mapper;
 	Bus bus;
-	MMC* mmc;
 	DMA dma;
 	Joypad joypad1;
 	Timer timer;
@@ -40,15 +47,19 @@ public:
 
 	bool romLoaded = false;
 	int32_t clockAligner = 0;
+	SyncMode syncMode = SyncMode::Scheduled;
 
 	GBCEmulator();
+	~GBCEmulator();
 
 	void Reset();
-	bool LoadROM(uint8_t* data, uint32_t romSize);
+	bool LoadROM(std::shared_ptr<const ROMImage> image);
+	bool LoadROM(const uint8_t* data, uint32_t romSize);
 	void Run(uint32_t cpuCycles);
 	void Step();
 	bool IsFrameReady();
 	void ResetFrameReadyFlag();
+	void SetFrameSkip(FrameSkipMode mode, uint32_t skip = 0, uint32_t interval = 1);
 	SaveState* GetSaveState();
 	SaveState* CreateSaveState();
 	void SetSaveState(SaveState* state);
@@ -59,6 +70,6 @@ public:
 private:
 	std::string romName = "norom";
 	SaveState* saveState = nullptr;
-	MMC* CreateMMC(MMCType type);
+	void CreateMapper(MMCType type);
 };
 
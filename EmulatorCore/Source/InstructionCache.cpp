@@ -0,0 +1,75 @@
+#include "InstructionCache.h"
+#include "CPU.h"
+#include "Bus.h"
+
+// Memory writes may switch banks or change code; STOP, HALT and EI change the
+// state the interpreter checks before each instruction.
+static bool EndsBlock(uint8_t opcode, uint8_t secondaryOpcode) {
+	switch (opcode) {
+	case 0x10: case 0x76: case 0xfb:
+	case 0x02: case 0x08: case 0x12: case 0x22: case 0x32: case 0x34: case 0x35: case 0x36:
+	case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x77:
+	case 0xc4: case 0xc5: case 0xcc: case 0xcd: case 0xd4: case 0xd5: case 0xdc:
+	case 0xe0: case 0xe2: case 0xe5: case 0xea: case 0xf5:
+		return true;
+	case 0xcb:
+		return (secondaryOpcode & 7) == 6 && (secondaryOpcode < 0x40 || secondaryOpcode >= 0x80);
+	}
+	return opcode >= 0xc0 && (opcode & 7) == 7;
+}
+
+InstructionCache::InstructionCache(CPU& cpu, Bus& bus) : cpu(cpu), bus(bus) {}
+
+const DecodedInstruction* InstructionCache::Lookup(uint16_t pc) {
+	uint8_t page = pc >> 8;
+	if (page >= 0x80 && (page < 0xc0 || page >= 0xe0)) return nullptr;
+	const uint8_t* memory = bus.readPages[page];
+	if (!memory) return nullptr;
+
+	if (memory != lastMemory) {
+		auto found = pages.find(memory);
+		if (found == pages.end()) {
+			found = pages.emplace(memory, DecodedPage()).first;
+			pageMemory[page].push_back(memory);
+			bus.WatchCodePage(page);
+		}
+		lastMemory = memory;
+		lastPage = &found->second;
+	}
+	DecodedInstruction& instruction = lastPage->instructions[pc & 0xff];
+	if (!instruction.length) Decode(instruction, memory, pc & 0xff);
+	return instruction.crossesPage ? nullptr : &instruction;
+}
+
+void InstructionCache::InvalidatePage(uint8_t page) {
+	for (const uint8_t* memory : pageMemory[page]) {
+		pages.erase(memory);
+	}
+	pageMemory[page].clear();
+	lastMemory = nullptr;
+	lastPage = nullptr;
+}
+
+void InstructionCache::Flush() {
+	pages.clear();
+	for (std::vector<const uint8_t*>& memory : pageMemory) {
+		memory.clear();
+	}
+	lastMemory = nullptr;
+	lastPage = nullptr;
+}
+
+// Prefixed instructions are decoded as two byte instructions with the second
+// opcode as operand and both timings folded in.
+void InstructionCache::Decode(DecodedInstruction& instruction, const uint8_t* memory, uint8_t offset) {
+	instruction.opcode = memory[offset];
+	instruction.length = instruction.opcode == 0xcb ? 2 : cpu.baseOpcodeTable[instruction.opcode].length;
+	instruction.crossesPage = offset + instruction.length > 0x100;
+	if (instruction.crossesPage) return;
+
+	if (instruction.length == 2) instruction.operand = memory[offset + 1];
+	if (instruction.length == 3) instruction.operand = memory[offset + 1] | (memory[offset + 2] << 8);
+	instruction.cycles = cpu.opcodeTimingTable[instruction.opcode] * 4;
+	if (instruction.opcode == 0xcb) instruction.cycles += cpu.prefixOpcodeTimingTable[instruction.operand] * 4;
+	instruction.endsBlock = offset + instruction.length == 0x100 || EndsBlock(instruction.opcode, (uint8_t)instruction.operand);
+}
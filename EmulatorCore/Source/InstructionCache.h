@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <unordered_map>
+
+class CPU;
+class Bus;
+
+struct DecodedInstruction {
+	uint16_t operand = 0;
+	uint8_t opcode = 0;
+	uint8_t length = 0; // 0 until decoded
+	uint8_t cycles = 0;
+	// Set when execution can't continue with the next record of the same page.
+	bool endsBlock = false;
+	bool crossesPage = false;
+};
+
+// Instructions from ROM and WRAM decoded once into records indexed by host page,
+// so ROM banks keep their records across bank switches. Written WRAM pages are
+// watched through the bus and dropped when their bytes change.
+class InstructionCache {
+public:
+	InstructionCache(CPU& cpu, Bus& bus);
+
+	const DecodedInstruction* Lookup(uint16_t pc);
+	void InvalidatePage(uint8_t page);
+	void Flush();
+
+private:
+	struct DecodedPage {
+		std::array<DecodedInstruction, 0x100> instructions;
+	};
+
+	CPU& cpu;
+	Bus& bus;
+	std::unordered_map<const uint8_t*, DecodedPage> pages;
+	std::array<std::vector<const uint8_t*>, 0x100> pageMemory;
+	const uint8_t* lastMemory = nullptr;
+	DecodedPage* lastPage = nullptr;
+
+	void Decode(DecodedInstruction& instruction, const uint8_t* memory, uint8_t offset);
+};
@@ -0,0 +1,778 @@
+#include "JIT.h"
+#include "CPU.h"
+#include "Bus.h"
+#include "Log.h"
+#include <algorithm>
+#ifdef GBC_JIT
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+// Flag bits of the F register.
+static const uint8_t FlagZ = 0x80;
+static const uint8_t FlagN = 0x40;
+static const uint8_t FlagH = 0x20;
+static const uint8_t FlagC = 0x10;
+static const uint8_t FlagsAll = FlagZ | FlagN | FlagH | FlagC;
+
+// x86 register numbers used in ModRM bytes. RDX holds the CPU pointer, R8 the
+// host page of a memory access, ECX the offset into it, R9D a saved byte and
+// R10 a resolved push address.
+static const uint8_t AL = 0;
+static const uint8_t CL = 1;
+static const uint8_t AH = 4;
+static const uint8_t CH = 5;
+
+static const uint32_t MaxBlockBytes = JIT::MaxBlockInstructions * 256;
+
+JIT::JIT(CPU& cpu, Bus& bus) : cpu(cpu), bus(bus) {}
+
+JIT::~JIT() {
+#ifdef GBC_JIT
+	if (!code) return;
+#ifdef _WIN32
+	VirtualFree(code, 0, MEM_RELEASE);
+#else
+	munmap(code, CodeSize);
+#endif
+#endif
+}
+
+JITBlock* JIT::Lookup(uint16_t pc) {
+#ifdef GBC_JIT
+	uint8_t page = pc >> 8;
+	if (page >= 0x80 && (page < 0xc0 || page >= 0xe0)) return nullptr;
+	const uint8_t* memory = bus.readPages[page];
+	if (!memory) return nullptr;
+
+	// Host addresses tell ROM and WRAM banks apart; the PC tells mirrors apart.
+	uint64_t key = (uint64_t)(uintptr_t)(memory + (pc & 0xff)) ^ ((uint64_t)pc << 48);
+	CacheEntry& entry = lookupCache[(key ^ (key >> 12) ^ (key >> 48)) & (lookupCache.size() - 1)];
+	if (entry.block && entry.key == key) return entry.block->code ? entry.block : nullptr;
+
+	auto found = blocks.find(key);
+	if (found == blocks.end()) {
+		JITBlock block = Compile(pc, memory);
+		found = blocks.emplace(key, block).first;
+		pageBlocks[page].push_back(key);
+		bus.WatchCodePage(page);
+	}
+	entry.key = key;
+	entry.block = &found->second;
+	return found->second.code ? &found->second : nullptr;
+#else
+	return nullptr;
+#endif
+}
+
+// Returns the cycles spent, or 0 when the block left before its first instruction.
+uint32_t JIT::Execute(const JITBlock& block) {
+	// Translated code works on F directly.
+	cpu.ResolveFlags();
+	if (!verify) {
+		uint32_t result = block.code();
+		cpu.clock += result & 0xffff;
+		cpu.instructions += result >> 16;
+		return result & 0xffff;
+	}
+
+	// Run the translation, rewind registers and writable memory, interpret the same
+	// instructions and keep the interpreter's result.
+	Registers initial = SaveRegisters();
+	SaveMemory(initialMemory);
+	uint32_t result = block.code();
+	Registers translated = SaveRegisters();
+	SaveMemory(translatedMemory);
+	LoadRegisters(initial);
+	LoadMemory(initialMemory);
+	uint32_t cycles = 0;
+	for (uint32_t i = 0; i < (result >> 16); i++) {
+		cycles += cpu.Step();
+	}
+	Registers interpreted = SaveRegisters();
+	SaveMemory(initialMemory);
+	if ((result & 0xffff) != cycles || translated.AF != interpreted.AF || translated.BC != interpreted.BC || translated.DE != interpreted.DE ||
+		translated.HL != interpreted.HL || translated.SP != interpreted.SP || translated.PC != interpreted.PC || translated.IME != interpreted.IME ||
+		translatedMemory != initialMemory) {
+		mismatches++;
+		CoreLog() << std::hex << "JIT mismatch in block at 0x" << initial.PC << ": AF=" << translated.AF << "/" << interpreted.AF
+			<< " BC=" << translated.BC << "/" << interpreted.BC << " DE=" << translated.DE << "/" << interpreted.DE
+			<< " HL=" << translated.HL << "/" << interpreted.HL << " SP=" << translated.SP << "/" << interpreted.SP
+			<< " PC=" << translated.PC << "/" << interpreted.PC << std::dec << " cycles=" << (result & 0xffff) << "/" << cycles
+			<< (translatedMemory != initialMemory ? " memory differs" : "") << "\n";
+	}
+	return cycles;
+}
+
+void JIT::InvalidatePage(uint8_t page) {
+	for (uint64_t key : pageBlocks[page]) {
+		blocks.erase(key);
+	}
+	pageBlocks[page].clear();
+	lookupCache.fill({});
+}
+
+void JIT::Flush() {
+	blocks.clear();
+	for (std::vector<uint64_t>& keys : pageBlocks) {
+		keys.clear();
+	}
+	lookupCache.fill({});
+	codeUsed = 0;
+}
+
+JITBlock JIT::Compile(uint16_t pc, const uint8_t* page) {
+	JITBlock block;
+#ifdef GBC_JIT
+	if (!code) {
+#ifdef _WIN32
+		code = (uint8_t*)VirtualAlloc(nullptr, CodeSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+#else
+		void* memory = mmap(nullptr, CodeSize, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		code = memory == MAP_FAILED ? nullptr : (uint8_t*)memory;
+#endif
+		if (!code) {
+			CoreLog() << "Could not allocate JIT code memory.\n";
+			return block;
+		}
+	}
+	if (CodeSize - codeUsed < MaxBlockBytes) Flush();
+
+	uint8_t* start = code + codeUsed;
+	cursor = start;
+	EmitBytes({ 0x48, 0xba }); // mov rdx, imm64
+	Emit64((uint64_t)(uintptr_t)&cpu);
+
+	uint32_t offset = pc & 0xff;
+	uint16_t address = pc;
+	uint32_t cycles = 0;
+	uint32_t branchCycles = 0;
+	EmitResult result = EmitResult::Next;
+	while (block.instructions < MaxBlockInstructions && offset < 0x100) {
+		uint8_t opcode = page[offset];
+		uint32_t length = opcode == 0xcb ? 2 : cpu.baseOpcodeTable[opcode].length;
+		if (offset + length > 0x100) break;
+		uint32_t instructionCycles = cpu.opcodeTimingTable[opcode] * 4;
+		if (opcode == 0xcb) instructionCycles += cpu.prefixOpcodeTimingTable[page[offset + 1]] * 4;
+		uint16_t next = address + length;
+		// Jumps closing an idle loop stay with the interpreter, which skips the loop.
+		int32_t target = length == 1 ? -1 : CPU::JumpTarget(opcode, length == 3 ? page[offset + 1] | (page[offset + 2] << 8) : page[offset + 1], next);
+		if (cpu.skipIdleLoops && target >= 0 && target < next && next - target <= CPU::MaxIdleLoopLength && cpu.AnalyzeIdleLoop(target, next)) break;
+		exitPC = address;
+		exitCycles = cycles;
+		exitInstructions = block.instructions;
+		branchCycles = cycles + instructionCycles;
+		uint8_t* instructionStart = cursor;
+		result = EmitInstruction(opcode, page + offset + 1, length, next, cycles + instructionCycles, branchCycles);
+		if (result == EmitResult::Unsupported) {
+			cursor = instructionStart;
+			break;
+		}
+		cycles += instructionCycles;
+		block.instructions++;
+		address = next;
+		offset += length;
+		if (result == EmitResult::Exit) break;
+	}
+	if (!block.instructions) return block;
+	if (result != EmitResult::Exit) {
+		EmitExit(address, cycles, block.instructions);
+		branchCycles = cycles;
+	}
+
+	block.code = (uint32_t(*)())start;
+	block.maxCycles = branchCycles;
+	codeUsed += (uint32_t)(cursor - start);
+#endif
+	return block;
+}
+
+JIT::EmitResult JIT::EmitInstruction(uint8_t opcode, const uint8_t* operands, uint32_t length, uint16_t next, uint32_t cycles, uint32_t& branchCycles) {
+	// Operands past the instruction may lie past the end of the page.
+	uint16_t n16 = length == 3 ? operands[0] | (operands[1] << 8) : 0;
+	uint32_t instructions = exitInstructions + 1;
+	const void* registers16[] = { &cpu.BC, &cpu.DE, &cpu.HL, &cpu.SP };
+	const void* stackRegisters[][2] = { { &cpu.C, &cpu.B }, { &cpu.E, &cpu.D }, { &cpu.L, &cpu.H }, { &cpu.F, &cpu.A } };
+
+	if (opcode == 0x76) return EmitResult::Unsupported;
+	if (opcode >= 0x40 && opcode < 0x80) {
+		uint8_t destination = (opcode >> 3) & 7;
+		uint8_t source = opcode & 7;
+		if (source == 6) {
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(false);
+			EmitBytes({ 0x41, 0x8a, 0x04, 0x08 }); // mov al, [r8 + rcx]
+		}
+		else if (destination != source) {
+			EmitMemoryOperand(0x8a, AL, Register8(source));
+		}
+		if (destination == 6) {
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(true);
+			EmitMemoryOperand(0x8a, AL, Register8(source));
+			EmitBytes({ 0x41, 0x88, 0x04, 0x08 }); // mov [r8 + rcx], al
+		}
+		else if (destination != source) {
+			EmitMemoryOperand(0x88, AL, Register8(destination));
+		}
+		return EmitResult::Next;
+	}
+	if (opcode >= 0x80 && opcode < 0xc0) {
+		if ((opcode & 7) == 6) {
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(false);
+			EmitBytes({ 0x41, 0x8a, 0x04, 0x08 }); // mov al, [r8 + rcx]
+			EmitBytes({ 0x88, 0xc1 }); // mov cl, al
+		}
+		else {
+			EmitMemoryOperand(0x8a, CL, Register8(opcode & 7));
+		}
+		EmitALU((opcode >> 3) & 7);
+		return EmitResult::Next;
+	}
+	if (opcode >= 0xc0 && (opcode & 7) == 6) {
+		EmitBytes({ 0xb1, operands[0] }); // mov cl, imm8
+		EmitALU((opcode >> 3) & 7);
+		return EmitResult::Next;
+	}
+	if (opcode >= 0xc0 && (opcode & 7) == 7) {
+		EmitPush(nullptr, nullptr, next);
+		EmitExit(opcode & 0x38, cycles, instructions);
+		return EmitResult::Exit;
+	}
+	if (opcode < 0x40 && (opcode & 7) >= 4 && (opcode & 7) <= 6) {
+		uint8_t index = (opcode >> 3) & 7;
+		if ((opcode & 7) == 6) {
+			if (index == 6) {
+				EmitAddress(&cpu.HL);
+				EmitPageLookup(true);
+				EmitBytes({ 0xb0, operands[0] }); // mov al, imm8
+				EmitBytes({ 0x41, 0x88, 0x04, 0x08 });
+			}
+			else {
+				EmitMemoryOperand(0xc6, 0, Register8(index)); // mov byte [r], imm8
+				Emit8(operands[0]);
+			}
+			return EmitResult::Next;
+		}
+		if (index == 6) {
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(false);
+			EmitBytes({ 0x41, 0x8a, 0x04, 0x08 });
+			EmitBytes({ 0x44, 0x0f, 0xb6, 0xc8 }); // movzx r9d, al
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(true);
+			EmitBytes({ 0x44, 0x89, 0xc8 }); // mov eax, r9d
+			EmitBytes({ 0xfe, (uint8_t)((opcode & 7) == 4 ? 0xc0 : 0xc8) }); // inc al / dec al
+			EmitBytes({ 0x41, 0x88, 0x04, 0x08 });
+		}
+		else {
+			EmitMemoryOperand(0x8a, AL, Register8(index));
+			EmitBytes({ 0xfe, (uint8_t)((opcode & 7) == 4 ? 0xc0 : 0xc8) });
+			EmitMemoryOperand(0x88, AL, Register8(index));
+		}
+		EmitFlags(FlagZ | FlagH, (opcode & 7) == 5 ? FlagN : 0, FlagZ | FlagN | FlagH, false);
+		return EmitResult::Next;
+	}
+
+	switch (opcode) {
+	case 0x00:
+		return EmitResult::Next;
+	case 0x01:
+	case 0x11:
+	case 0x21:
+	case 0x31:
+		Emit8(0x66); // mov word [rr], imm16
+		EmitMemoryOperand(0xc7, 0, registers16[opcode >> 4]);
+		Emit16(n16);
+		return EmitResult::Next;
+	case 0x03:
+	case 0x13:
+	case 0x23:
+	case 0x33:
+	case 0x0b:
+	case 0x1b:
+	case 0x2b:
+	case 0x3b:
+		Emit8(0x66); // inc/dec word [rr]
+		EmitMemoryOperand(0xff, (opcode & 8) ? 1 : 0, registers16[opcode >> 4]);
+		return EmitResult::Next;
+	case 0x09:
+	case 0x19:
+	case 0x29:
+	case 0x39:
+		// Adding the high bytes with carry leaves the bit 11 carry in AF.
+		Emit8(0x66);
+		EmitMemoryOperand(0x8b, AL, &cpu.HL);
+		Emit8(0x66);
+		EmitMemoryOperand(0x8b, CL, registers16[opcode >> 4]);
+		EmitBytes({ 0x00, 0xc8 }); // add al, cl
+		EmitBytes({ 0x10, 0xec }); // adc ah, ch
+		Emit8(0x66);
+		EmitMemoryOperand(0x89, AL, &cpu.HL);
+		EmitFlags(FlagH | FlagC, 0, FlagN | FlagH | FlagC, false);
+		return EmitResult::Next;
+	case 0x02:
+	case 0x12:
+	case 0x22:
+	case 0x32:
+	case 0xea:
+		if (opcode == 0xea) EmitAddress(n16);
+		else EmitAddress(opcode < 0x20 ? registers16[opcode >> 4] : &cpu.HL);
+		EmitPageLookup(true);
+		EmitMemoryOperand(0x8a, AL, &cpu.A);
+		EmitBytes({ 0x41, 0x88, 0x04, 0x08 });
+		if (opcode == 0x22 || opcode == 0x32) {
+			Emit8(0x66);
+			EmitMemoryOperand(0xff, opcode == 0x22 ? 0 : 1, &cpu.HL);
+		}
+		return EmitResult::Next;
+	case 0x0a:
+	case 0x1a:
+	case 0x2a:
+	case 0x3a:
+	case 0xfa:
+		if (opcode == 0xfa) EmitAddress(n16);
+		else EmitAddress(opcode < 0x20 ? registers16[opcode >> 4] : &cpu.HL);
+		EmitPageLookup(false);
+		EmitBytes({ 0x41, 0x8a, 0x04, 0x08 });
+		EmitMemoryOperand(0x88, AL, &cpu.A);
+		if (opcode == 0x2a || opcode == 0x3a) {
+			Emit8(0x66);
+			EmitMemoryOperand(0xff, opcode == 0x2a ? 0 : 1, &cpu.HL);
+		}
+		return EmitResult::Next;
+	case 0x07:
+	case 0x0f:
+	case 0x17:
+	case 0x1f:
+		if (opcode >= 0x10) EmitLoadCarry();
+		EmitMemoryOperand(0x8a, AL, &cpu.A);
+		EmitBytes({ 0xd0, (uint8_t)(0xc0 | ((opcode >> 3) << 3)) }); // rol/ror/rcl/rcr al, 1
+		EmitBytes({ 0x0f, 0x92, 0xc5 }); // setc ch
+		EmitMemoryOperand(0x88, AL, &cpu.A);
+		EmitFlags(0, 0, FlagsAll, true);
+		return EmitResult::Next;
+	case 0x2f:
+		EmitMemoryOperand(0xf6, 2, &cpu.A); // not byte [A]
+		EmitMemoryOperand(0x80, 1, &cpu.F); // or byte [F], imm8
+		Emit8(FlagN | FlagH);
+		return EmitResult::Next;
+	case 0x37:
+		EmitMemoryOperand(0x80, 4, &cpu.F); // and byte [F], imm8
+		Emit8((uint8_t)~(FlagN | FlagH | FlagC));
+		EmitMemoryOperand(0x80, 1, &cpu.F);
+		Emit8(FlagC);
+		return EmitResult::Next;
+	case 0x3f:
+		EmitMemoryOperand(0x80, 4, &cpu.F);
+		Emit8((uint8_t)~(FlagN | FlagH));
+		EmitMemoryOperand(0x80, 6, &cpu.F); // xor byte [F], imm8
+		Emit8(FlagC);
+		return EmitResult::Next;
+	case 0xf3:
+		EmitMemoryOperand(0xc6, 0, &cpu.IME);
+		Emit8(0);
+		return EmitResult::Next;
+	case 0xf9:
+		Emit8(0x66);
+		EmitMemoryOperand(0x8b, AL, &cpu.HL);
+		Emit8(0x66);
+		EmitMemoryOperand(0x89, AL, &cpu.SP);
+		return EmitResult::Next;
+	case 0xc1:
+	case 0xd1:
+	case 0xe1:
+		EmitPop(registers16[(opcode >> 4) & 3], 0xffff);
+		return EmitResult::Next;
+	case 0xf1:
+		EmitPop(&cpu.AF, 0xfff0);
+		return EmitResult::Next;
+	case 0xc5:
+	case 0xd5:
+	case 0xe5:
+	case 0xf5:
+		EmitPush(stackRegisters[(opcode >> 4) & 3][0], stackRegisters[(opcode >> 4) & 3][1], 0);
+		return EmitResult::Next;
+	case 0xcb:
+		return EmitPrefixInstruction(operands[0]);
+	case 0x18:
+		EmitExit(next + (int8_t)operands[0], cycles, instructions);
+		return EmitResult::Exit;
+	case 0xc3:
+		EmitExit(n16, cycles, instructions);
+		return EmitResult::Exit;
+	case 0xe9:
+		Emit8(0x66);
+		EmitMemoryOperand(0x8b, AL, &cpu.HL);
+		Emit8(0x66);
+		EmitMemoryOperand(0x89, AL, &cpu.PC);
+		EmitReturn(cycles, instructions);
+		return EmitResult::Exit;
+	case 0xcd:
+		EmitPush(nullptr, nullptr, next);
+		EmitExit(n16, cycles, instructions);
+		return EmitResult::Exit;
+	case 0xc9:
+	case 0xd9:
+		EmitPop(&cpu.PC, 0xffff);
+		if (opcode == 0xd9) {
+			EmitMemoryOperand(0xc6, 0, &cpu.IME);
+			Emit8(1);
+		}
+		EmitReturn(cycles, instructions);
+		return EmitResult::Exit;
+	case 0x20:
+	case 0x28:
+	case 0x30:
+	case 0x38:
+	case 0xc2:
+	case 0xca:
+	case 0xd2:
+	case 0xda:
+	case 0xc4:
+	case 0xcc:
+	case 0xd4:
+	case 0xdc:
+	case 0xc0:
+	case 0xc8:
+	case 0xd0:
+	case 0xd8: {
+		uint8_t* jump = EmitConditionalJump((opcode >> 3) & 3);
+		if (opcode < 0x40) {
+			branchCycles = cycles + 4;
+			EmitExit(next + (int8_t)operands[0], branchCycles, instructions);
+		}
+		else if ((opcode & 7) == 2) {
+			branchCycles = cycles + 4;
+			EmitExit(n16, branchCycles, instructions);
+		}
+		else if ((opcode & 7) == 4) {
+			branchCycles = cycles + 12;
+			EmitPush(nullptr, nullptr, next);
+			EmitExit(n16, branchCycles, instructions);
+		}
+		else {
+			branchCycles = cycles + 12;
+			EmitPop(&cpu.PC, 0xffff);
+			EmitReturn(branchCycles, instructions);
+		}
+		PatchJump(jump);
+		EmitExit(next, cycles, instructions);
+		return EmitResult::Exit;
+	}
+	}
+	return EmitResult::Unsupported;
+}
+
+JIT::EmitResult JIT::EmitPrefixInstruction(uint8_t opcode) {
+	uint8_t index = opcode & 7;
+	uint8_t bit = (opcode >> 3) & 7;
+	const void* field = Register8(index);
+
+	switch (opcode >> 6) {
+	case 0: {
+		if (index == 6) return EmitResult::Unsupported;
+		// rlc, rrc, rl, rr, sla, sra, swap, srl map onto rol, ror, rcl, rcr, shl, sar, rol 4, shr.
+		static const uint8_t operations[] = { 0, 1, 2, 3, 4, 7, 0, 5 };
+		if (bit == 2 || bit == 3) EmitLoadCarry();
+		EmitMemoryOperand(0x8a, AL, field);
+		if (bit == 6) {
+			EmitBytes({ 0xc0, 0xc0, 0x04 }); // rol al, 4
+		}
+		else {
+			EmitBytes({ 0xd0, (uint8_t)(0xc0 | (operations[bit] << 3)) });
+			EmitBytes({ 0x0f, 0x92, 0xc5 }); // setc ch
+		}
+		EmitBytes({ 0x84, 0xc0 }); // test al, al
+		EmitMemoryOperand(0x88, AL, field);
+		EmitFlags(FlagZ, 0, FlagsAll, bit != 6);
+		return EmitResult::Next;
+	}
+	case 1:
+		if (index == 6) {
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(false);
+			EmitBytes({ 0x41, 0x8a, 0x04, 0x08 });
+		}
+		else {
+			EmitMemoryOperand(0x8a, AL, field);
+		}
+		EmitBytes({ 0xa8, (uint8_t)(1 << bit) }); // test al, imm8
+		EmitFlags(FlagZ, FlagH, FlagZ | FlagN | FlagH, false);
+		return EmitResult::Next;
+	default:
+		if (index == 6) {
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(false);
+			EmitBytes({ 0x41, 0x8a, 0x04, 0x08 });
+			EmitBytes({ 0x44, 0x0f, 0xb6, 0xc8 }); // movzx r9d, al
+			EmitAddress(&cpu.HL);
+			EmitPageLookup(true);
+			EmitBytes({ 0x44, 0x89, 0xc8 }); // mov eax, r9d
+			if (opcode >> 6 == 2) EmitBytes({ 0x24, (uint8_t)~(1 << bit) }); // and al, imm8
+			else EmitBytes({ 0x0c, (uint8_t)(1 << bit) }); // or al, imm8
+			EmitBytes({ 0x41, 0x88, 0x04, 0x08 });
+		}
+		else if (opcode >> 6 == 2) {
+			EmitMemoryOperand(0x80, 4, field);
+			Emit8((uint8_t)~(1 << bit));
+		}
+		else {
+			EmitMemoryOperand(0x80, 1, field);
+			Emit8(1 << bit);
+		}
+		return EmitResult::Next;
+	}
+}
+
+// Operation index as encoded in bits 3-5 of the SM83 opcode, operand in CL.
+void JIT::EmitALU(uint8_t operation) {
+	static const uint8_t hostOpcodes[] = { 0x00, 0x10, 0x28, 0x18, 0x20, 0x30, 0x08, 0x38 };
+	if (operation == 1 || operation == 3) EmitLoadCarry();
+	EmitMemoryOperand(0x8a, AL, &cpu.A);
+	EmitBytes({ hostOpcodes[operation], 0xc8 }); // op al, cl
+	if (operation != 7) EmitMemoryOperand(0x88, AL, &cpu.A);
+	switch (operation) {
+	case 0:
+	case 1:
+		EmitFlags(FlagZ | FlagH | FlagC, 0, FlagsAll, false);
+		break;
+	case 2:
+	case 3:
+	case 7:
+		EmitFlags(FlagZ | FlagH | FlagC, FlagN, FlagsAll, false);
+		break;
+	case 4:
+		EmitFlags(FlagZ, FlagH, FlagsAll, false);
+		break;
+	default:
+		EmitFlags(FlagZ, 0, FlagsAll, false);
+		break;
+	}
+}
+
+// Pushes the register pair low/high, or the immediate value when no register is
+// given. Both addresses are looked up before storing, so a side exit writes nothing.
+void JIT::EmitPush(const void* low, const void* high, uint16_t value) {
+	EmitAddress(&cpu.SP);
+	EmitBytes({ 0x66, 0x83, 0xe8, 0x01 }); // sub ax, 1
+	EmitPageLookup(true);
+	EmitBytes({ 0x4d, 0x8d, 0x14, 0x08 }); // lea r10, [r8 + rcx]
+	EmitAddress(&cpu.SP);
+	EmitBytes({ 0x66, 0x83, 0xe8, 0x02 }); // sub ax, 2
+	EmitPageLookup(true);
+	if (high) EmitMemoryOperand(0x8a, AL, high);
+	else EmitBytes({ 0xb0, (uint8_t)(value >> 8) }); // mov al, imm8
+	EmitBytes({ 0x41, 0x88, 0x02 }); // mov [r10], al
+	if (low) {
+		EmitMemoryOperand(0x8a, AL, low);
+		if (low == &cpu.F) EmitBytes({ 0x24, 0xf0 }); // and al, 0xf0
+	}
+	else {
+		EmitBytes({ 0xb0, (uint8_t)(value & 0xff) });
+	}
+	EmitBytes({ 0x41, 0x88, 0x04, 0x08 });
+	Emit8(0x66); // sub word [SP], 2
+	EmitMemoryOperand(0x83, 5, &cpu.SP);
+	Emit8(2);
+}
+
+void JIT::EmitPop(const void* destination, uint16_t mask) {
+	EmitAddress(&cpu.SP);
+	EmitPageLookup(false);
+	EmitBytes({ 0x41, 0x8a, 0x04, 0x08 });
+	EmitBytes({ 0x44, 0x0f, 0xb6, 0xc8 }); // movzx r9d, al
+	EmitAddress(&cpu.SP);
+	EmitBytes({ 0x66, 0xff, 0xc0 }); // inc ax
+	EmitPageLookup(false);
+	EmitBytes({ 0x41, 0x8a, 0x04, 0x08 });
+	EmitBytes({ 0x0f, 0xb6, 0xc0 }); // movzx eax, al
+	EmitBytes({ 0xc1, 0xe0, 0x08 }); // shl eax, 8
+	EmitBytes({ 0x44, 0x09, 0xc8 }); // or eax, r9d
+	if (mask != 0xffff) {
+		Emit8(0x25); // and eax, imm32
+		Emit32(mask);
+	}
+	Emit8(0x66);
+	EmitMemoryOperand(0x89, AL, destination);
+	Emit8(0x66); // add word [SP], 2
+	EmitMemoryOperand(0x83, 0, &cpu.SP);
+	Emit8(2);
+}
+
+void JIT::EmitAddress(const void* field) {
+	Emit8(0x0f); // movzx eax, word [field]
+	EmitMemoryOperand(0xb7, AL, field);
+}
+
+void JIT::EmitAddress(uint16_t address) {
+	Emit8(0xb8); // mov eax, imm32
+	Emit32(address);
+}
+
+// Looks up the bus page for the address in EAX, leaving the host page in R8 and
+// the offset in ECX. Pages without a host pointer leave the block before the
+// current instruction.
+void JIT::EmitPageLookup(bool write) {
+	EmitBytes({ 0x89, 0xc1 }); // mov ecx, eax
+	EmitBytes({ 0xc1, 0xe9, 0x08 }); // shr ecx, 8
+	EmitBytes({ 0x49, 0xb8 }); // mov r8, imm64
+	Emit64((uint64_t)(uintptr_t)(write ? bus.writePages.data() : bus.readPages.data()));
+	EmitBytes({ 0x4d, 0x8b, 0x04, 0xc8 }); // mov r8, [r8 + rcx * 8]
+	EmitBytes({ 0x4d, 0x85, 0xc0 }); // test r8, r8
+	EmitBytes({ 0x75, 0x00 }); // jnz over the side exit
+	uint8_t* jump = cursor - 1;
+	EmitSideExit();
+	*jump = (uint8_t)(cursor - jump - 1);
+	EmitBytes({ 0x0f, 0xb6, 0xc8 }); // movzx ecx, al
+}
+
+// Blocks return the cycles spent in the low 16 bits and the instructions executed above them.
+void JIT::EmitExit(uint16_t pc, uint32_t cycles, uint32_t instructions) {
+	Emit8(0x66); // mov word [PC], imm16
+	EmitMemoryOperand(0xc7, 0, &cpu.PC);
+	Emit16(pc);
+	EmitReturn(cycles, instructions);
+}
+
+void JIT::EmitReturn(uint32_t cycles, uint32_t instructions) {
+	Emit8(0xb8); // mov eax, imm32
+	Emit32((instructions << 16) | cycles);
+	Emit8(0xc3); // ret
+}
+
+void JIT::EmitSideExit() {
+	EmitExit(exitPC, exitCycles, exitInstructions);
+}
+
+// Condition as encoded in SM83 opcodes: NZ, Z, NC, C. The returned jump is
+// taken when the condition fails and must be patched past the taken path.
+uint8_t* JIT::EmitConditionalJump(uint8_t condition) {
+	EmitMemoryOperand(0xf6, 0, &cpu.F); // test byte [F], imm8
+	Emit8(condition < 2 ? FlagZ : FlagC);
+	EmitBytes({ 0x0f, (uint8_t)((condition & 1) ? 0x84 : 0x85) }); // jz/jnz rel32
+	uint8_t* jump = cursor;
+	Emit32(0);
+	return jump;
+}
+
+void JIT::PatchJump(uint8_t* jump) {
+	int32_t distance = (int32_t)(cursor - jump - 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		jump[i] = (uint8_t)(distance >> (i * 8));
+	}
+}
+
+// Converts host flags from LAHF (ZF bit 6, AF bit 4, CF bit 0) into SM83 flags
+// and merges them into F, leaving flags outside writtenFlags untouched.
+void JIT::EmitFlags(uint8_t hostFlags, uint8_t setFlags, uint8_t writtenFlags, bool carryInCH) {
+	if (hostFlags) {
+		Emit8(0x9f); // lahf
+		EmitBytes({ 0x88, 0xe1 }); // mov cl, ah
+		EmitBytes({ 0x80, 0xe1, 0x50 }); // and cl, 0x50
+		EmitBytes({ 0x00, 0xc9 }); // add cl, cl
+		EmitBytes({ 0x80, 0xe4, 0x01 }); // and ah, 1
+		EmitBytes({ 0xc0, 0xe4, 0x04 }); // shl ah, 4
+		EmitBytes({ 0x08, 0xe1 }); // or cl, ah
+		EmitBytes({ 0x80, 0xe1, hostFlags }); // and cl, hostFlags
+	}
+	else {
+		EmitBytes({ 0xb1, 0x00 }); // mov cl, 0
+	}
+	if (carryInCH) {
+		EmitBytes({ 0xc0, 0xe5, 0x04 }); // shl ch, 4
+		EmitBytes({ 0x08, 0xe9 }); // or cl, ch
+	}
+	if (setFlags) {
+		EmitBytes({ 0x80, 0xc9, setFlags }); // or cl, setFlags
+	}
+	EmitMemoryOperand(0x8a, AH, &cpu.F);
+	EmitBytes({ 0x80, 0xe4, (uint8_t)~writtenFlags }); // and ah, ~writtenFlags
+	EmitBytes({ 0x08, 0xcc }); // or ah, cl
+	EmitMemoryOperand(0x88, AH, &cpu.F);
+}
+
+// Moves the SM83 carry flag into the host carry flag through CH.
+void JIT::EmitLoadCarry() {
+	EmitMemoryOperand(0x8a, CH, &cpu.F);
+	EmitBytes({ 0xc0, 0xe5, 0x04 }); // shl ch, 4
+}
+
+void JIT::EmitMemoryOperand(uint8_t opcode, uint8_t reg, const void* field) {
+	int32_t offset = (int32_t)((const uint8_t*)field - (const uint8_t*)&cpu);
+	Emit8(opcode);
+	if (offset >= -128 && offset < 128) {
+		Emit8(0x42 | (reg << 3)); // [rdx + disp8]
+		Emit8((uint8_t)offset);
+	}
+	else {
+		Emit8(0x82 | (reg << 3)); // [rdx + disp32]
+		Emit32((uint32_t)offset);
+	}
+}
+
+void JIT::Emit8(uint8_t value) {
+	*cursor++ = value;
+}
+
+void JIT::Emit16(uint16_t value) {
+	Emit8(value & 0xff);
+	Emit8(value >> 8);
+}
+
+void JIT::Emit32(uint32_t value) {
+	Emit16(value & 0xffff);
+	Emit16(value >> 16);
+}
+
+void JIT::Emit64(uint64_t value) {
+	Emit32(value & 0xffffffff);
+	Emit32(value >> 32);
+}
+
+void JIT::EmitBytes(std::initializer_list<uint8_t> bytes) {
+	for (uint8_t value : bytes) {
+		Emit8(value);
+	}
+}
+
+const void* JIT::Register8(uint8_t index) {
+	const void* registers[] = { &cpu.B, &cpu.C, &cpu.D, &cpu.E, &cpu.H, &cpu.L, nullptr, &cpu.A };
+	return registers[index];
+}
+
+JIT::Registers JIT::SaveRegisters() {
+	cpu.ResolveFlags();
+	return { cpu.AF, cpu.BC, cpu.DE, cpu.HL, cpu.SP, cpu.PC, cpu.IME };
+}
+
+// Copies every page a translated block may write to.
+void JIT::SaveMemory(std::vector<uint8_t>& memory) {
+	memory.clear();
+	for (uint8_t* page : bus.writePages) {
+		if (page) memory.insert(memory.end(), page, page + 0x100);
+	}
+}
+
+void JIT::LoadMemory(const std::vector<uint8_t>& memory) {
+	size_t offset = 0;
+	for (uint8_t* page : bus.writePages) {
+		if (!page) continue;
+		std::copy(memory.begin() + offset, memory.begin() + offset + 0x100, page);
+		offset += 0x100;
+	}
+}
+
+void JIT::LoadRegisters(const Registers& registers) {
+	cpu.AF = registers.AF;
+	cpu.BC = registers.BC;
+	cpu.DE = registers.DE;
+	cpu.HL = registers.HL;
+	cpu.SP = registers.SP;
+	cpu.PC = registers.PC;
+	cpu.IME = registers.IME;
+}
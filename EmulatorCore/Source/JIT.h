@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+
+// Translation needs an x86-64 host; elsewhere the CPU keeps interpreting.
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(GBC_NO_JIT)
+#define GBC_JIT
+#endif
+
+class CPU;
+class Bus;
+
+struct JITBlock {
+	uint32_t (*code)() = nullptr;
+	uint32_t instructions = 0;
+	uint32_t maxCycles = 0;
+};
+
+// Translates SM83 basic blocks from ROM and WRAM into x86-64 code with their
+// cycle counts folded in. Memory accesses use the bus page table directly and
+// leave the block at any page without a host pointer (I/O, VRAM and OAM
+// writes, pages holding translated code), so the interpreter performs every
+// access that has side effects.
+class JIT {
+public:
+	static const uint32_t CodeSize = 0x100000;
+	static const uint32_t MaxBlockInstructions = 64;
+
+	bool verify = false;
+	uint64_t mismatches = 0;
+
+	JIT(CPU& cpu, Bus& bus);
+	~JIT();
+
+	JITBlock* Lookup(uint16_t pc);
+	uint32_t Execute(const JITBlock& block);
+	void InvalidatePage(uint8_t page);
+	void Flush();
+
+private:
+	enum class EmitResult {
+		Unsupported,
+		Next,
+		Exit
+	};
+
+	struct CacheEntry {
+		uint64_t key = 0;
+		JITBlock* block = nullptr;
+	};
+
+	struct Registers {
+		uint16_t AF, BC, DE, HL, SP, PC;
+		uint8_t IME;
+	};
+
+	CPU& cpu;
+	Bus& bus;
+	uint8_t* code = nullptr;
+	uint32_t codeUsed = 0;
+	uint8_t* cursor = nullptr;
+	std::unordered_map<uint64_t, JITBlock> blocks;
+	std::array<std::vector<uint64_t>, 0x100> pageBlocks;
+	std::array<CacheEntry, 0x1000> lookupCache;
+
+	// State before the instruction being translated, used by side exits.
+	uint16_t exitPC = 0;
+	uint32_t exitCycles = 0;
+	uint32_t exitInstructions = 0;
+
+	std::vector<uint8_t> initialMemory;
+	std::vector<uint8_t> translatedMemory;
+
+	JITBlock Compile(uint16_t pc, const uint8_t* page);
+	EmitResult EmitInstruction(uint8_t opcode, const uint8_t* operands, uint32_t length, uint16_t next, uint32_t cycles, uint32_t& branchCycles);
+	EmitResult EmitPrefixInstruction(uint8_t opcode);
+	void EmitALU(uint8_t operation);
+	void EmitPush(const void* low, const void* high, uint16_t value);
+	void EmitPop(const void* destination, uint16_t mask);
+	void EmitAddress(const void* field);
+	void EmitAddress(uint16_t address);
+	void EmitPageLookup(bool write);
+	void EmitExit(uint16_t pc, uint32_t cycles, uint32_t instructions);
+	void EmitReturn(uint32_t cycles, uint32_t instructions);
+	void EmitSideExit();
+	uint8_t* EmitConditionalJump(uint8_t condition);
+	void PatchJump(uint8_t* jump);
+	void EmitFlags(uint8_t hostFlags, uint8_t setFlags, uint8_t writtenFlags, bool carryInCH);
+	void EmitLoadCarry();
+	void EmitMemoryOperand(uint8_t opcode, uint8_t reg, const void* field);
+	void Emit8(uint8_t value);
+	void Emit16(uint16_t value);
+	void Emit32(uint32_t value);
+	void Emit64(uint64_t value);
+	void EmitBytes(std::initializer_list<uint8_t> bytes);
+	const void* Register8(uint8_t index);
+
+	Registers SaveRegisters();
+	void LoadRegisters(const Registers& registers);
+	void SaveMemory(std::vector<uint8_t>& memory);
+	void LoadMemory(const std::vector<uint8_t>& memory);
+};
@@ -0,0 +1,13 @@
+#include "Log.h"
+#include <iostream>
+
+static thread_local std::ostream mutedLog(nullptr);
+static thread_local std::ostream* coreLog = &std::cout;
+
+std::ostream& CoreLog() {
+	return *coreLog;
+}
+
+void SetCoreLog(std::ostream* stream) {
+	coreLog = stream ? stream : &mutedLog;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <ostream>
+
+// Core messages go to a stream chosen per thread, so emulators running on
+// different threads never share stream state. Defaults to std::cout.
+std::ostream& CoreLog();
+// nullptr mutes the core on the calling thread.
+void SetCoreLog(std::ostream* stream);
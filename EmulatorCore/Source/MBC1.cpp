@@ -1,73 +1,46 @@
 #include "MBC1.h"
+#include "Bus.h"
+#include "Log.h"
+#include <algorithm>
 
-MBC1::MBC1(Bus& bus) : MMC(bus) {}
+MBC1::MBC1(Bus& bus) : MapperBase(bus) {}
 
-void MBC1::Reset() {
+void MBC1::ResetRegisters() {
 	RAMEnable = 0;
-	ROMBank = 0;
+	ROMBank = 1;
 	RAMBank = 0;
 	mode = 0;
 }
 
-void MBC1::LoadROM(uint8_t* data, uint32_t romSize) {
-	PrintROMInfo(data, romSize);
-	ROMBanksCount = (2 << data[0x148]);
-	switch (data[0x149]) {
-	case 0x00:
-		RAMBanksCount = 1;
-		break;
-	case 0x01:
-		RAMBanksCount = 1;
-		break;
-	case 0x02:
-		RAMBanksCount = 1;
-		break;
-	case 0x03:
-		RAMBanksCount = 4;
-		break;
-	case 0x04:
-		RAMBanksCount = 4;
-		std::cout << "Error: RAM size is to big for mapper.\n";
-		break;
-	case 0x05:
-		RAMBanksCount = 4;
-		std::cout << "Error: RAM size is to big for mapper.\n";
-		break;
-	}
-	for (int32_t i = 0; i < ROMBanksCount && i < romBanks.size(); i++) {
-		for (int32_t j = 0; j < 0x4000; j++) {
-			romBanks[i][j] = data[i * 0x4000 + j];
-		}
-	}
+void MBC1::LoadROM(std::shared_ptr<const ROMImage> image) {
+	AttachROM(image);
+	ROMBanksCount = (uint16_t)(romSize / ROMBankSize);
+	uint32_t ramSize = GetRAMSize(rom);
+	if (ramSize > 4 * RAMBankSize) {
+		CoreLog() << "Error: RAM size is to big for mapper.\n";
+		ramSize = 4 * RAMBankSize;
+	}
+	ramSize = std::max(ramSize, RAMBankSize);
+	RAMBanksCount = (uint8_t)(ramSize / RAMBankSize);
+	eram.assign(ramSize, 0);
+	UpdateMemoryMap();
 }
 
-uint8_t MBC1::Read8(uint16_t address) {
+uint8_t MBC1::ReadCartridge(uint16_t address) {
 	if (address < 0x4000) {
-		return romBanks[GetROMBank0()][address];
+		return rom[GetROMBank0() * ROMBankSize + address];
 	}
 	else if (address < 0x8000) {
-		return romBanks[GetROMBank()][address - 0x4000];
-	}
-	else if (address < 0xa000) {
-		return vram[address - 0x8000];
-	}
-	else if (address < 0xc000) {
-		if (!RAMEnable) {
-			std::cout << "Read from disabled RAM.\n";
-			return 0xff;
-		}
-		return ramBanks[GetRAMBank()][address - 0xa000];
-	}
-	else if (address < 0xd000) {
-		return wram0[address - 0xc000];
+		return rom[GetROMBank() * ROMBankSize + address - 0x4000];
 	}
-	else if (address < 0xe000) {
-		return wram1[address - 0xd000];
+	if (!RAMEnable) {
+		CoreLog() << "Read from disabled RAM.\n";
+		return 0xff;
 	}
-	return 0;
+	return eram[GetRAMBank() * RAMBankSize + address - 0xa000];
 }
 
-void MBC1::Write8(uint16_t address, uint8_t value) {
+void MBC1::WriteCartridge(uint16_t address, uint8_t value) {
 	if (address < 0x8000) {
 		if (address < 0x2000) {
 			RAMEnable = (value & 0x0f) == 0x0a;
@@ -82,135 +55,57 @@ void MBC1::Write8(uint16_t address, uint8_t value) {
 		else {
 			mode = value & 1;
 		}
+		MapBanks();
 	}
-	else if (address < 0xa000) {
-		vram[address - 0x8000] = value;
-	}
-	else if (address < 0xc000) {
+	else {
 		if (!RAMEnable) {
-			std::cout << "Write ti disabled RAM\n";
+			CoreLog() << "Write ti disabled RAM\n";
 			return;
 		}
-		ramBanks[GetRAMBank()][address - 0xa000] = value;
-	}
-	else if (address < 0xd000) {
-		wram0[address - 0xc000] = value;
-	}
-	else if (address < 0xe000) {
-		wram1[address - 0xd000] = value;
+		eram[GetRAMBank() * RAMBankSize + address - 0xa000] = value;
 	}
 }
 
-uint8_t MBC1::ReadHRAM(uint16_t address) {
-	return hram[address & 0xff];
+void MBC1::MapBanks() {
+	if (!rom) return;
+	uint8_t* ram = RAMEnable ? &eram[GetRAMBank() * RAMBankSize] : nullptr;
+	MapCartridge(rom + GetROMBank0() * ROMBankSize, rom + GetROMBank() * ROMBankSize, ram);
 }
 
-void MBC1::WriteHRAM(uint16_t address, uint8_t value) {
-	hram[address & 0xff] = value;
-}
-
-uint8_t MBC1::ReadOAM(uint16_t address) {
-	return oam[address - 0xfe00];
-}
-
-void MBC1::WriteOAM(uint16_t address, uint8_t value) {
-	oam[address - 0xfe00] = value;
-}
-
-OAMEntry* MBC1::GetOAMEntry(uint8_t index) {
-	return(OAMEntry*)&oam[(index % 40) * 4];
-}
-
-uint8_t MBC1::GetROMBank0() {
+uint32_t MBC1::GetROMBank0() {
 	if (mode && ROMBanksCount > 32) {
-		return RAMBank << 5;
+		return (RAMBank << 5) % ROMBanksCount;
 	}
 	return 0;
 }
 
-uint8_t MBC1::GetROMBank() {
+uint32_t MBC1::GetROMBank() {
 	if (ROMBanksCount > 32) {
-		return (RAMBank << 5) | ROMBank;
+		return ((RAMBank << 5) | ROMBank) % ROMBanksCount;
 	}
 	if (ROMBank == 0) return 1;
-	return ROMBank & (ROMBanksCount - 1);
+	return ROMBank % ROMBanksCount;
 }
 
-uint8_t MBC1::GetRAMBank() {
+uint32_t MBC1::GetRAMBank() {
 	if (mode) {
-		return RAMBank & 0b11;
+		return RAMBank & (RAMBanksCount - 1);
 	}
 	return 0;
 }
 
-void MBC1::WriteState(SaveState& state) {
-	state.Write8(ROMBanksCount);
-	state.Write8(RAMBanksCount);
+void MBC1::WriteRegisters(SaveState& state) {
 	state.Write8(multicart);
 	state.Write8(RAMEnable);
 	state.Write8(ROMBank);
 	state.Write8(RAMBank);
 	state.Write8(mode);
-
-	for (size_t i = 0; i < vram.size(); i++) {
-		state.Write8(vram[i]);
-	}
-
-	for (size_t i = 0; i < ramBanks.size(); i++) {
-		for (size_t j = 0; j < ramBanks[i].size(); j++) {
-			state.Write8(ramBanks[i][j]);
-		}
-	}
-
-	for (size_t i = 0; i < wram0.size(); i++) {
-		state.Write8(wram0[i]);
-	}
-
-	for (size_t i = 0; i < wram1.size(); i++) {
-		state.Write8(wram1[i]);
-	}
-
-	for (size_t i = 0; i < oam.size(); i++) {
-		state.Write8(oam[i]);
-	}
-
-	for (size_t i = 0; i < hram.size(); i++) {
-		state.Write8(hram[i]);
-	}
 }
 
-void MBC1::LoadState(SaveState& state) {
-	ROMBanksCount = state.Read8();
-	RAMBanksCount = state.Read8();
+void MBC1::LoadRegisters(SaveState& state) {
 	multicart = state.Read8();
 	RAMEnable = state.Read8();
 	ROMBank = state.Read8();
 	RAMBank = state.Read8();
 	mode = state.Read8();
-
-	for (size_t i = 0; i < vram.size(); i++) {
-		vram[i] = state.Read8();
-	}
-
-	for (size_t i = 0; i < ramBanks.size(); i++) {
-		for (size_t j = 0; j < ramBanks[i].size(); j++) {
-			ramBanks[i][j] = state.Read8();
-		}
-	}
-
-	for (size_t i = 0; i < wram0.size(); i++) {
-		wram0[i] = state.Read8();
-	}
-
-	for (size_t i = 0; i < wram1.size(); i++) {
-		wram1[i] = state.Read8();
-	}
-
-	for (size_t i = 0; i < oam.size(); i++) {
-		oam[i] = state.Read8();
-	}
-
-	for (size_t i = 0; i < hram.size(); i++) {
-		hram[i] = state.Read8();
-	}
 }
@@ -0,0 +1,138 @@
+#include "MBC3.h"
+#include "Bus.h"
+#include "Log.h"
+#include <algorithm>
+
+MBC3::MBC3(Bus& bus) : MapperBase(bus) {}
+
+void MBC3::ResetRegisters() {
+	RAMEnable = 0;
+	ROMBank = 1;
+	RAMBank = 0;
+	latch = 0xff;
+	rtc.fill(0);
+	latchedRTC.fill(0);
+	rtcTimestamp = 0;
+}
+
+void MBC3::LoadROM(std::shared_ptr<const ROMImage> image) {
+	AttachROM(image);
+	ROMBanksCount = (uint16_t)(romSize / ROMBankSize);
+	uint32_t ramSize = GetRAMSize(rom);
+	if (ramSize > 4 * RAMBankSize) {
+		CoreLog() << "Error: RAM size is to big for mapper.\n";
+		ramSize = 4 * RAMBankSize;
+	}
+	ramSize = std::max(ramSize, RAMBankSize);
+	RAMBanksCount = (uint8_t)(ramSize / RAMBankSize);
+	eram.assign(ramSize, 0);
+	UpdateMemoryMap();
+}
+
+uint8_t MBC3::ReadCartridge(uint16_t address) {
+	if (address < 0x4000) {
+		return rom[address];
+	}
+	else if (address < 0x8000) {
+		return rom[(ROMBank % ROMBanksCount) * ROMBankSize + address - 0x4000];
+	}
+	if (!RAMEnable) {
+		return 0xff;
+	}
+	if (IsRTCSelected()) {
+		return latchedRTC[RAMBank - 0x08];
+	}
+	return eram[(RAMBank & (RAMBanksCount - 1)) * RAMBankSize + address - 0xa000];
+}
+
+void MBC3::WriteCartridge(uint16_t address, uint8_t value) {
+	if (address < 0x8000) {
+		if (address < 0x2000) {
+			RAMEnable = (value & 0x0f) == 0x0a;
+		}
+		else if (address < 0x4000) {
+			ROMBank = value & 0x7f;
+			if (ROMBank == 0) ROMBank = 1;
+		}
+		else if (address < 0x6000) {
+			RAMBank = value & 0x0f;
+		}
+		else {
+			if (latch == 0x00 && value == 0x01) {
+				UpdateRTC();
+				latchedRTC = rtc;
+			}
+			latch = value;
+		}
+		MapBanks();
+	}
+	else if (RAMEnable) {
+		if (IsRTCSelected()) {
+			UpdateRTC();
+			// Writing the seconds also restarts the current second.
+			if (RAMBank == 0x08 + Seconds) rtcTimestamp = bus.scheduler.Now();
+			rtc[RAMBank - 0x08] = value;
+			latchedRTC[RAMBank - 0x08] = value;
+		}
+		else {
+			eram[(RAMBank & (RAMBanksCount - 1)) * RAMBankSize + address - 0xa000] = value;
+		}
+	}
+}
+
+// Clock registers change with time, so only a selected RAM bank is mapped.
+void MBC3::MapBanks() {
+	if (!rom) return;
+	uint8_t* ram = RAMEnable && RAMBank < 0x08 ? &eram[(RAMBank & (RAMBanksCount - 1)) * RAMBankSize] : nullptr;
+	MapCartridge(rom, rom + (ROMBank % ROMBanksCount) * ROMBankSize, ram);
+}
+
+bool MBC3::IsRTCSelected() {
+	return RAMBank >= 0x08 && RAMBank <= 0x0c;
+}
+
+void MBC3::UpdateRTC() {
+	uint64_t now = bus.scheduler.Now();
+	if (now < rtcTimestamp || (rtc[DaysHigh] & 0x40)) {
+		rtcTimestamp = now;
+		return;
+	}
+	uint64_t seconds = (now - rtcTimestamp) / CyclesPerSecond;
+	if (!seconds) return;
+	rtcTimestamp += seconds * CyclesPerSecond;
+
+	uint64_t total = rtc[Seconds] + seconds;
+	rtc[Seconds] = total % 60;
+	total = rtc[Minutes] + total / 60;
+	rtc[Minutes] = total % 60;
+	total = rtc[Hours] + total / 60;
+	rtc[Hours] = total % 24;
+	uint64_t days = (((rtc[DaysHigh] & 1) << 8) | rtc[DaysLow]) + total / 24;
+	if (days > 0x1ff) rtc[DaysHigh] |= 0x80;
+	rtc[DaysLow] = days & 0xff;
+	rtc[DaysHigh] = (rtc[DaysHigh] & 0xfe) | ((days >> 8) & 1);
+}
+
+void MBC3::WriteRegisters(SaveState& state) {
+	UpdateRTC();
+	state.Write8(RAMEnable);
+	state.Write8(ROMBank);
+	state.Write8(RAMBank);
+	state.Write8(latch);
+	for (size_t i = 0; i < rtc.size(); i++) {
+		state.Write8(rtc[i]);
+		state.Write8(latchedRTC[i]);
+	}
+}
+
+void MBC3::LoadRegisters(SaveState& state) {
+	RAMEnable = state.Read8();
+	ROMBank = state.Read8();
+	RAMBank = state.Read8();
+	latch = state.Read8();
+	for (size_t i = 0; i < rtc.size(); i++) {
+		rtc[i] = state.Read8();
+		latchedRTC[i] = state.Read8();
+	}
+	rtcTimestamp = bus.scheduler.Now();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "MMC.h"
+
+class Bus;
+
+// MBC3 with its real-time clock. The clock counts emulated cycles rather than
+// host time, so runs stay reproducible.
+class MBC3 : public MapperBase<MBC3> {
+public:
+	static const uint32_t CyclesPerSecond = 0x400000;
+
+	MBC3(Bus& bus);
+
+	void LoadROM(std::shared_ptr<const ROMImage> image);
+
+private:
+	enum RTCRegister {
+		Seconds,
+		Minutes,
+		Hours,
+		DaysLow,
+		DaysHigh
+	};
+
+	uint16_t ROMBanksCount;
+	uint8_t RAMBanksCount;
+	uint8_t RAMEnable;
+	uint8_t ROMBank;
+	// 0x00-0x03 select a RAM bank, 0x08-0x0c a clock register.
+	uint8_t RAMBank;
+	uint8_t latch;
+	std::array<uint8_t, 5> rtc;
+	std::array<uint8_t, 5> latchedRTC;
+	uint64_t rtcTimestamp;
+
+	uint8_t ReadCartridge(uint16_t address);
+	void WriteCartridge(uint16_t address, uint8_t value);
+	void MapBanks();
+	void ResetRegisters();
+	void WriteRegisters(SaveState& state);
+	void LoadRegisters(SaveState& state);
+
+	bool IsRTCSelected();
+	void UpdateRTC();
+
+	friend class MapperBase<MBC3>;
+};
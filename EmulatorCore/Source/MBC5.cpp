@@ -0,0 +1,81 @@
+#include "MBC5.h"
+#include "Bus.h"
+#include <algorithm>
+
+MBC5::MBC5(Bus& bus) : MapperBase(bus) {}
+
+void MBC5::ResetRegisters() {
+	RAMEnable = 0;
+	ROMBank = 1;
+	RAMBank = 0;
+}
+
+void MBC5::LoadROM(std::shared_ptr<const ROMImage> image) {
+	AttachROM(image);
+	ROMBanksCount = (uint16_t)(romSize / ROMBankSize);
+	uint32_t ramSize = std::max(GetRAMSize(rom), RAMBankSize);
+	RAMBanksCount = (uint8_t)(ramSize / RAMBankSize);
+	eram.assign(ramSize, 0);
+	UpdateMemoryMap();
+}
+
+uint8_t MBC5::ReadCartridge(uint16_t address) {
+	if (address < 0x4000) {
+		return rom[address];
+	}
+	else if (address < 0x8000) {
+		return rom[GetROMBank() * ROMBankSize + address - 0x4000];
+	}
+	if (!RAMEnable) {
+		return 0xff;
+	}
+	return eram[GetRAMBank() * RAMBankSize + address - 0xa000];
+}
+
+void MBC5::WriteCartridge(uint16_t address, uint8_t value) {
+	if (address < 0x8000) {
+		if (address < 0x2000) {
+			RAMEnable = (value & 0x0f) == 0x0a;
+		}
+		else if (address < 0x3000) {
+			ROMBank = (ROMBank & 0x100) | value;
+		}
+		else if (address < 0x4000) {
+			ROMBank = (ROMBank & 0xff) | ((value & 1) << 8);
+		}
+		else if (address < 0x6000) {
+			// Bit 3 drives the rumble motor on rumble carts.
+			RAMBank = value & 0x0f;
+		}
+		MapBanks();
+	}
+	else if (RAMEnable) {
+		eram[GetRAMBank() * RAMBankSize + address - 0xa000] = value;
+	}
+}
+
+void MBC5::MapBanks() {
+	if (!rom) return;
+	uint8_t* ram = RAMEnable ? &eram[GetRAMBank() * RAMBankSize] : nullptr;
+	MapCartridge(rom, rom + GetROMBank() * ROMBankSize, ram);
+}
+
+uint32_t MBC5::GetROMBank() {
+	return ROMBank % ROMBanksCount;
+}
+
+uint32_t MBC5::GetRAMBank() {
+	return RAMBank & (RAMBanksCount - 1);
+}
+
+void MBC5::WriteRegisters(SaveState& state) {
+	state.Write8(RAMEnable);
+	state.Write16(ROMBank);
+	state.Write8(RAMBank);
+}
+
+void MBC5::LoadRegisters(SaveState& state) {
+	RAMEnable = state.Read8();
+	ROMBank = state.Read16();
+	RAMBank = state.Read8();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "MMC.h"
+
+class Bus;
+
+class MBC5 : public MapperBase<MBC5> {
+public:
+	MBC5(Bus& bus);
+
+	void LoadROM(std::shared_ptr<const ROMImage> image);
+
+private:
+	uint16_t ROMBanksCount;
+	uint8_t RAMBanksCount;
+	uint8_t RAMEnable;
+	// 9 bits; unlike MBC1 and MBC3, bank 0 can be mapped at 0x4000.
+	uint16_t ROMBank;
+	uint8_t RAMBank;
+
+	uint8_t ReadCartridge(uint16_t address);
+	void WriteCartridge(uint16_t address, uint8_t value);
+	void MapBanks();
+	void ResetRegisters();
+	void WriteRegisters(SaveState& state);
+	void LoadRegisters(SaveState& state);
+
+	uint32_t GetROMBank();
+	uint32_t GetRAMBank();
+
+	friend class MapperBase<MBC5>;
+};
@@ -1,4 +1,7 @@
 #include "MMC.h"
+#include "Bus.h"
+#include "Log.h"
+#include <algorithm>
 #include <vector>
 
 const std::vector<uint8_t> initialTileData = {
@@ -101,16 +104,21 @@ std::string MMCTypeToString(MMCType type) {
 	}
 }
 
-MMC::MMC(Bus& bus) : bus(bus) {}
+MMC::MMC(Bus& bus) : bus(bus), tileCache(vram), spriteCache(oam.data()) {}
 
 void MMC::Reset() {
 	for (int32_t i = 0; i < hram.size(); i++) {
 		hram[i] = 0xff;
 	}
+	// Fresh instances must not start from leftover heap contents, or identical runs diverge.
 	for (int32_t i = 0; i < vram.size(); i++) {
-		vram[0][i] = 0x00;
-		vram[1][i] = 0x00;
+		vram[i].fill(0x00);
 	}
+	for (int32_t i = 0; i < wram.size(); i++) {
+		wram[i].fill(0x00);
+	}
+	oam.fill(0x00);
+	spriteCache.Invalidate();
 	for (int32_t i = 0; i < initialTileData.size(); i++) {
 		vram[0][i * 2 + 0x10] = initialTileData[i];
 		vram[1][i * 2 + 0x10] = initialTileData[i];
@@ -119,104 +127,114 @@ void MMC::Reset() {
 		vram[0][i + 0x1904] = initialTileMapData[i];
 		vram[1][i + 0x1904] = initialTileMapData[i];
 	}
+	tileCache.InvalidateAll();
 	VBK = 0;
 	SVBK = 1;
 }
 
-void MMC::LoadROM(uint8_t* data, uint32_t romSize) {
-	PrintROMInfo(data, romSize);
-	for (uint32_t i = 0; i < romSize; i++) {
-		Write8(i, data[i]);
+void MMC::AttachROM(std::shared_ptr<const ROMImage> image) {
+	PrintROMInfo(image->GetData(), image->GetFileSize());
+	romImage = image;
+	rom = romImage->GetData();
+	romSize = romImage->GetSize();
+}
+
+uint32_t MMC::GetROMSize(const uint8_t* data, uint32_t romSize) {
+	if (data[0x148] <= 8) return 0x8000 << data[0x148];
+	return std::max((romSize + ROMBankSize - 1) / ROMBankSize, 2u) * ROMBankSize;
+}
+
+uint32_t MMC::GetRAMSize(const uint8_t* data) {
+	switch (data[0x149]) {
+	case 0x01:
+	case 0x02:
+		return 0x2000;
+	case 0x03:
+		return 0x8000;
+	case 0x04:
+		return 0x20000;
+	case 0x05:
+		return 0x10000;
+	default:
+		return 0;
 	}
 }
 
-void MMC::PrintROMInfo(uint8_t* data, uint32_t romSize) {
-	std::cout << "ROM Memory Controller: " << MMCTypeToString((MMCType)data[0x147]) << "\n";
-	std::cout << "ROM Banks: " << (int32_t)(2 << data[0x148]) << "\n";
-	std::cout << "RAM Size: " << (int32_t)data[0x149] << "\n";
+void MMC::PrintROMInfo(const uint8_t* data, uint32_t romSize) {
+	CoreLog() << "ROM Memory Controller: " << MMCTypeToString((MMCType)data[0x147]) << "\n";
+	CoreLog() << "ROM Banks: " << (int32_t)(2 << data[0x148]) << "\n";
+	CoreLog() << "RAM Size: " << (int32_t)data[0x149] << "\n";
 	switch (data[0x149]) {
 	case 0x00:
-		std::cout << "RAM: No RAM\n";
+		CoreLog() << "RAM: No RAM\n";
 		break;
 	case 0x01:
-		std::cout << "RAM: Unused\n";
+		CoreLog() << "RAM: Unused\n";
 		break;
 	case 0x02:
-		std::cout << "RAM: 8KiB\n";
+		CoreLog() << "RAM: 8KiB\n";
 		break;
 	case 0x03:
-		std::cout << "RAM: 32KiB\n";
+		CoreLog() << "RAM: 32KiB\n";
 		break;
 	case 0x04:
-		std::cout << "RAM: 128KiB\n";
+		CoreLog() << "RAM: 128KiB\n";
 		break;
 	case 0x05:
-		std::cout << "RAM: 64KiB\n";
+		CoreLog() << "RAM: 64KiB\n";
 		break;
 	}
 }
 
-uint8_t MMC::Read8(uint16_t address) {
-	if (address < 0x4000) {
-		return rom0[address];
-	}
-	else if (address < 0x8000) {
-		return rom1[address - 0x4000];
-	}
-	else if (address < 0xa000) {
-		return vram[VBK & 1][address - 0x8000];
-	}
-	else if (address < 0xc000) {
-		return eram[address - 0xa000];
+uint8_t MMC::ReadConsole(uint16_t address) {
+	if (address < 0xa000) {
+		return GetVRAMBank()[address - 0x8000];
 	}
 	else if (address < 0xd000) {
 		return wram[0][address - 0xc000];
 	}
-	else if (address < 0xe000) {
-		return wram[SVBK & 0b111][address - 0xd000];
-	}
-	return 0;
+	return GetWRAMBank()[address - 0xd000];
 }
 
-void MMC::Write8(uint16_t address, uint8_t value) {
-	if (address < 0x4000) {
-		rom0[address] = value;
-	}
-	else if (address < 0x8000) {
-		rom1[address - 0x4000] = value;
-	}
-	else if (address < 0xa000) {
-		vram[VBK & 1][address - 0x8000] = value;
-	}
-	else if (address < 0xc000) {
-		eram[address - 0xa000] = value;
+void MMC::WriteConsole(uint16_t address, uint8_t value) {
+	if (address < 0xa000) {
+		GetVRAMBank()[address - 0x8000] = value;
+		tileCache.Invalidate(VBK & 1, address - 0x8000);
 	}
 	else if (address < 0xd000) {
 		wram[0][address - 0xc000] = value;
 	}
-	else if (address < 0xe000) {
-		wram[SVBK & 0b111][address - 0xd000] = value;
+	else {
+		GetWRAMBank()[address - 0xd000] = value;
 	}
 }
 
-uint8_t MMC::ReadHRAM(uint16_t address) {
-	return hram[address & 0xff];
+void MMC::MapConsoleMemory() {
+	bus.MapPages(0x8000, 0x2000, GetVRAMBank(), nullptr);
+	bus.MapPages(0xc000, 0x1000, wram[0].data(), wram[0].data());
+	bus.MapPages(0xd000, 0x1000, GetWRAMBank(), GetWRAMBank());
 }
 
-void MMC::WriteHRAM(uint16_t address, uint8_t value) {
-	hram[address & 0xff] = value;
+void MMC::MapCartridge(const uint8_t* rom0, const uint8_t* rom1, uint8_t* ram) {
+	if (!cartridgeMapValid || rom0 != mappedROM0) bus.MapPages(0x0000, 0x4000, rom0, nullptr);
+	if (!cartridgeMapValid || rom1 != mappedROM1) bus.MapPages(0x4000, 0x4000, rom1, nullptr);
+	if (!cartridgeMapValid || ram != mappedRAM) bus.MapPages(0xa000, 0x2000, ram, ram);
+	mappedROM0 = rom0;
+	mappedROM1 = rom1;
+	mappedRAM = ram;
+	cartridgeMapValid = true;
 }
 
-uint8_t MMC::ReadOAM(uint16_t address) {
-	return oam[address - 0xfe00];
+void MMC::InvalidateCartridgeMap() {
+	cartridgeMapValid = false;
 }
 
-void MMC::WriteOAM(uint16_t address, uint8_t value) {
-	oam[address - 0xfe00] = value;
+uint8_t* MMC::GetVRAMBank() {
+	return vram[VBK & 1].data();
 }
 
-OAMEntry* MMC::GetOAMEntry(uint8_t index) {
-	return (OAMEntry*)&oam[(index % 40) * 4];
+uint8_t* MMC::GetWRAMBank() {
+	return wram[SVBK & 0b111].data();
 }
 
 uint8_t MMC::ReadVBK() {
@@ -229,11 +247,13 @@ uint8_t MMC::ReadSVBK() {
 
 void MMC::WriteVBK(uint8_t value) {
 	VBK = value | 0xfe;
+	MapConsoleMemory();
 }
 
 void MMC::WriteSVBK(uint8_t value) {
 	SVBK = value;
 	if ((SVBK & 0b111) == 0) SVBK |= 1;
+	MapConsoleMemory();
 }
 
 void MMC::WriteState(SaveState& state) {
@@ -274,6 +294,7 @@ void MMC::LoadState(SaveState& state) {
 			vram[i][j] = state.Read8();
 		}
 	}
+	tileCache.InvalidateAll();
 
 	for (size_t i = 0; i < eram.size(); i++) {
 		eram[i] = state.Read8();
@@ -288,8 +309,11 @@ void MMC::LoadState(SaveState& state) {
 	for (size_t i = 0; i < oam.size(); i++) {
 		oam[i] = state.Read8();
 	}
+	spriteCache.Invalidate();
 
 	for (size_t i = 0; i < hram.size(); i++) {
 		hram[i] = state.Read8();
 	}
+
+	MapConsoleMemory();
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 #include <cstdint>
 #include <array>
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <iostream>
 #include "OAMEntry.h"
 #include "SaveState.h"
+#include "ROMImage.h"
+#include "TileCache.h"
+#include "SpriteCache.h"
 
 class Bus;
 
@@ -41,48 +46,130 @@ enum class MMCType {
 
 std::string MMCTypeToString(MMCType type);
 
+// Memory shared by every cartridge type: the ROM image, cartridge RAM and the
+// console's VRAM, WRAM, OAM and HRAM. Mapper behaviour is added at compile time
+// by MapperBase, so nothing here is virtual.
 class MMC {
 public:
-	static const uint32_t OAMSize = 0xA0;
+	static constexpr uint32_t OAMSize = 0xA0;
+	static constexpr uint32_t ROMBankSize = 0x4000;
+	static constexpr uint32_t RAMBankSize = 0x2000;
 
 	MMC(Bus& bus);
 
-	
 	void Reset();
-	virtual void LoadROM(uint8_t* data, uint32_t romSize);
-	void PrintROMInfo(uint8_t* data, uint32_t romSize);
+	void PrintROMInfo(const uint8_t* data, uint32_t romSize);
+	// Cartridge sizes from the header, falling back to the file size for unknown codes.
+	static uint32_t GetROMSize(const uint8_t* data, uint32_t romSize);
+	static uint32_t GetRAMSize(const uint8_t* data);
 
-	virtual uint8_t Read8(uint16_t address);
-	virtual void Write8(uint16_t address, uint8_t value);
-	virtual uint8_t ReadHRAM(uint16_t address);
-	virtual void WriteHRAM(uint16_t address, uint8_t value);
-	virtual uint8_t ReadOAM(uint16_t address);
-	virtual void WriteOAM(uint16_t address, uint8_t value);
-	virtual OAMEntry* GetOAMEntry(uint8_t index);
+	uint8_t ReadHRAM(uint16_t address) { return hram[address & 0xff]; }
+	void WriteHRAM(uint16_t address, uint8_t value) { hram[address & 0xff] = value; }
+	uint8_t ReadOAM(uint16_t address) { return oam[address - 0xfe00]; }
+	void WriteOAM(uint16_t address, uint8_t value) {
+		oam[address - 0xfe00] = value;
+		spriteCache.InvalidateY(address - 0xfe00);
+	}
+	void WriteOAMBlock(uint32_t offset, const uint8_t* data, uint32_t size) {
+		std::copy(data, data + size, &oam[offset]);
+		spriteCache.Invalidate();
+	}
+	void WriteVRAMBlock(uint16_t address, const uint8_t* data, uint32_t size) {
+		std::copy(data, data + size, GetVRAMBank() + (address - 0x8000));
+		tileCache.Invalidate(VBK & 1, address - 0x8000, size);
+	}
+	OAMEntry* GetOAMEntry(uint8_t index) { return (OAMEntry*)&oam[(index % 40) * 4]; }
 
 	uint8_t ReadVBK();
 	uint8_t ReadSVBK();
 	void WriteVBK(uint8_t value);
 	void WriteSVBK(uint8_t value);
 
-	virtual void WriteState(SaveState& state);
-	virtual void LoadState(SaveState& state);
+	void WriteState(SaveState& state);
+	void LoadState(SaveState& state);
 
-private:
+protected:
 	Bus& bus;
 
+	// The only copy of cartridge and console memory. Mappers switch banks by
+	// remapping pages into these buffers instead of keeping their own arrays.
+	// ROM banks point straight into the shared image.
+	std::shared_ptr<const ROMImage> romImage;
+	const uint8_t* rom = nullptr;
+	uint32_t romSize = 0;
+	std::vector<uint8_t> eram;
+	std::array<std::array<uint8_t, 0x2000>, 2> vram = {};
+	TileCache tileCache;
+	std::array<std::array<uint8_t, 0x1000>, 8> wram;
+	std::array<uint8_t, OAMSize> oam = {};
+	SpriteCache spriteCache;
+	std::array<uint8_t, 0x100> hram;
+
+	void AttachROM(std::shared_ptr<const ROMImage> image);
+	// VRAM and WRAM, the part of 0x8000-0xdfff that doesn't belong to the cartridge.
+	uint8_t ReadConsole(uint16_t address);
+	void WriteConsole(uint16_t address, uint8_t value);
+	void MapConsoleMemory();
+	// Maps the cartridge windows at 0x0000, 0x4000 and 0xa000. Windows that keep
+	// their bank are skipped, so games that rewrite the bank register stay cheap.
+	void MapCartridge(const uint8_t* rom0, const uint8_t* rom1, uint8_t* ram);
+	void InvalidateCartridgeMap();
+	uint8_t* GetVRAMBank();
+	uint8_t* GetWRAMBank();
+
+private:
 	uint8_t VBK;
 	uint8_t SVBK;
-
-	std::array<uint8_t, 0x4000> rom0;
-	std::array<uint8_t, 0x4000> rom1;
-	std::array<std::array<uint8_t, 0x2000>,2> vram;
-	std::array<uint8_t, 0x2000> eram;
-	std::array< std::array<uint8_t, 0x1000>, 8> wram;
-	std::array<uint8_t, OAMSize> oam;
-	std::array<uint8_t, 0x100> hram;
+	const uint8_t* mappedROM0 = nullptr;
+	const uint8_t* mappedROM1 = nullptr;
+	const uint8_t* mappedRAM = nullptr;
+	bool cartridgeMapValid = false;
 
 	friend class Bus;
 	friend class PPU;
 };
 
+// Static interface of a cartridge mapper. Derived provides LoadROM, ReadCartridge,
+// WriteCartridge for 0x0000-0x7fff and 0xa000-0xbfff, MapBanks, ResetRegisters,
+// WriteRegisters and LoadRegisters. The bus picks the mapper once through the
+// Mapper variant, so every call below resolves at compile time.
+template <typename Derived>
+class MapperBase : public MMC {
+public:
+	MapperBase(Bus& bus) : MMC(bus) {}
+
+	void Reset() {
+		MMC::Reset();
+		Self().ResetRegisters();
+	}
+
+	uint8_t Read8(uint16_t address) {
+		if (address < 0x8000 || (address >= 0xa000 && address < 0xc000)) return Self().ReadCartridge(address);
+		return ReadConsole(address);
+	}
+
+	void Write8(uint16_t address, uint8_t value) {
+		if (address < 0x8000 || (address >= 0xa000 && address < 0xc000)) Self().WriteCartridge(address, value);
+		else WriteConsole(address, value);
+	}
+
+	void UpdateMemoryMap() {
+		MapConsoleMemory();
+		InvalidateCartridgeMap();
+		Self().MapBanks();
+	}
+
+	void WriteState(SaveState& state) {
+		MMC::WriteState(state);
+		Self().WriteRegisters(state);
+	}
+
+	void LoadState(SaveState& state) {
+		MMC::LoadState(state);
+		Self().LoadRegisters(state);
+		UpdateMemoryMap();
+	}
+
+private:
+	Derived& Self() { return static_cast<Derived&>(*this); }
+};
@@ -1,6 +1,21 @@
 #pragma once
+#include <variant>
 #include "MMC.h"
+#include "ROMOnly.h"
 #include "MBC1.h"
+#include "MBC3.h"
+#include "MBC5.h"
 
 class MMC;
+class ROMOnly;
 class MBC1;
+class MBC3;
+class MBC5;
+
+// The cartridge mapper, chosen once when a ROM is loaded. std::visit compiles
+// one call per mapper type, so accesses never go through a virtual function.
+using Mapper = std::variant<ROMOnly, MBC1, MBC3, MBC5>;
+
+inline MMC* GetMMC(Mapper& mapper) {
+	return std::visit([](auto& mmc) -> MMC* { return &mmc; }, mapper);
+}
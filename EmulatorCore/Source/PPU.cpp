@@ -1,13 +1,18 @@
 #include "PPU.h"
-
-const Color palette[] = {
-	Color(0.88f, 0.97f, 0.82f),
-	Color(0.53f, 0.75f, 0.44f),
-	Color(0.20f, 0.41f, 0.34f),
-	Color(0.03f, 0.09f, 0.13f),
+#include "Log.h"
+#include <cstring>
+#include <algorithm>
+
+const uint8_t PPU::shadeColors[4][3] = {
+	{ 224, 247, 209 },
+	{ 135, 191, 112 },
+	{ 51, 105, 87 },
+	{ 8, 23, 33 },
 };
 
-PPU::PPU(Bus& bus) : bus(bus) {}
+PPU::PPU(Bus& bus) : bus(bus) {
+	UpdatePaletteColors();
+}
 
 void PPU::Reset() {
 	dot = 0;
@@ -30,7 +35,25 @@ void PPU::Reset() {
 	mode = 2;
 	windowScanline = 0;
 	frameReady = false;
+	renderFrame = true;
+	frameSkipCounter = 0;
 	statInterruptionFlag = false;
+	UpdatePaletteColors();
+}
+
+void PPU::SetPixelFormat(PixelFormat format) {
+	for (FrameBuffer& frameBuffer : frameBuffers) {
+		frameBuffer.SetFormat(format);
+	}
+	UpdatePaletteColors();
+}
+
+void PPU::SetFrameSkip(FrameSkipMode mode, uint32_t skip, uint32_t interval) {
+	frameSkipMode = mode;
+	frameSkipInterval = std::max<uint32_t>(interval, 1);
+	// Fixed skipping always draws at least one frame of every interval.
+	frameSkip = mode == FrameSkipMode::Fixed ? std::min(skip, frameSkipInterval - 1) : skip;
+	frameSkipCounter = 0;
 }
 
 void PPU::StepPixelMode(uint32_t cycles) {
@@ -45,7 +68,7 @@ void PPU::StepPixelMode(uint32_t cycles) {
 			if (dot == (dotsPerScanline - 1)) {
 				if (LY == (screenHeight - 1)) {
 					mode = PPUMode::VBlank;
-					frameReady = true;
+					if (renderFrame) frameReady = true;
 					bus.TriggerInterruption(Interruption::VBlank);
 				}
 				else {
@@ -74,10 +97,11 @@ void PPU::StepPixelMode(uint32_t cycles) {
 		case PPUMode::Rendering:
 			if ((dot - 80) < screenWidth) {
 				if (dot % 8 == 0) SCX = (SCXBuffer & 0xf8) | (SCX & 0x07);
-				DrawPixel();
+				if (renderFrame) DrawPixel();
 			}
 			else if (dot == (91 + screenWidth)) {
 				mode = PPUMode::HBlank;
+				bus.dma.HBlank();
 			}
 			break;
 		}
@@ -90,8 +114,7 @@ void PPU::StepPixelMode(uint32_t cycles) {
 			if (LY == scanlineCount) {
 				LY = 0;
 				windowScanline = 0;
-				activeFrame = (activeFrame + 1) % 2;
-				frameBuffers[activeFrame].Reset();
+				StartFrame();
 				statInterruptionFlag = false;
 			}
 		}
@@ -105,78 +128,151 @@ void PPU::StepPixelMode(uint32_t cycles) {
 	}
 }
 
+// Catches up one span at a time. Dots that can't change the mode, LY, STAT or
+// raise an interruption are advanced in bulk, and only the dots that do go
+// through the full per-dot step.
 void PPU::StepScanlineMode(uint32_t cycles) {
 	//if (!LCDEnable) return;
 
-	for (uint32_t i = 0; i < cycles; i++) {
-		switch (mode) {
-		case PPUMode::HBlank:
-			if (!statInterruptionFlag && mode0IntSelect) {
-				bus.TriggerInterruption(Interruption::LCD);
-			}
-			if (dot == (dotsPerScanline - 1)) {
-				if (LY == (screenHeight - 1)) {
-					mode = PPUMode::VBlank;
-					frameReady = true;
-					bus.TriggerInterruption(Interruption::VBlank);
-				}
-				else {
-					mode = PPUMode::OAMScan;
-				}
-			}
-			break;
-		case PPUMode::VBlank:
-			if (!statInterruptionFlag && mode1IntSelect) {
-				bus.TriggerInterruption(Interruption::LCD);
+	while (cycles) {
+		uint32_t dots = std::min(QuietDots(), cycles);
+		if (dots) {
+			SkipQuietDots(dots);
+			cycles -= dots;
+		}
+		else {
+			StepScanlineDot();
+			cycles--;
+		}
+	}
+}
+
+// Number of dots from the current one that only draw pixels. Zero when the
+// current dot has to be stepped on its own, including after a register write
+// left LYCLY or the STAT line out of date.
+uint32_t PPU::QuietDots() {
+	bool coincidence = LY == LYC;
+	bool modeSelect = false;
+	switch (mode) {
+	case PPUMode::HBlank: modeSelect = mode0IntSelect; break;
+	case PPUMode::VBlank: modeSelect = mode1IntSelect; break;
+	case PPUMode::OAMScan: modeSelect = mode2IntSelect; break;
+	}
+	if (LYCLY != coincidence || statInterruptionFlag != (coincidence || modeSelect)) return 0;
+
+	uint32_t eventDot = dotsPerScanline - 1;
+	if (mode == PPUMode::OAMScan && dot <= 79) {
+		eventDot = 79;
+	}
+	else if (mode == PPUMode::Rendering && dot <= 80 + mode3Penalty + screenWidth) {
+		eventDot = std::min<uint32_t>(eventDot, 80 + mode3Penalty + screenWidth);
+	}
+	return eventDot > dot ? eventDot - dot : 0;
+}
+
+void PPU::SkipQuietDots(uint32_t dots) {
+	uint32_t end = dot + dots;
+	if (mode == PPUMode::Rendering) {
+		uint32_t first = std::max<uint32_t>(dot, 80);
+		uint32_t last = std::min<uint32_t>(end, 80 + screenWidth);
+		if (first < last) ComposePixels(first - 80, last - 80);
+	}
+	dot = end;
+}
+
+void PPU::StepScanlineDot() {
+	switch (mode) {
+	case PPUMode::HBlank:
+		if (!statInterruptionFlag && mode0IntSelect) {
+			bus.TriggerInterruption(Interruption::LCD);
+		}
+		if (dot == (dotsPerScanline - 1)) {
+			if (LY == (screenHeight - 1)) {
+				mode = PPUMode::VBlank;
+				if (renderFrame) frameReady = true;
+				bus.TriggerInterruption(Interruption::VBlank);
 			}
-			if (dot == (dotsPerScanline - 1) && LY == (scanlineCount - 1)) {
+			else {
 				mode = PPUMode::OAMScan;
 			}
-			break;
-		case PPUMode::OAMScan:
-			if (!statInterruptionFlag && mode2IntSelect) {
-				bus.TriggerInterruption(Interruption::LCD);
-			}
-			if (dot == 79) {
-				mode = PPUMode::Rendering;
-				SCX = SCXBuffer;
+		}
+		break;
+	case PPUMode::VBlank:
+		if (!statInterruptionFlag && mode1IntSelect) {
+			bus.TriggerInterruption(Interruption::LCD);
+		}
+		if (dot == (dotsPerScanline - 1) && LY == (scanlineCount - 1)) {
+			mode = PPUMode::OAMScan;
+		}
+		break;
+	case PPUMode::OAMScan:
+		if (!statInterruptionFlag && mode2IntSelect) {
+			bus.TriggerInterruption(Interruption::LCD);
+		}
+		if (dot == 79) {
+			mode = PPUMode::Rendering;
+			SCX = SCXBuffer;
+			UpdateMode3Penalty();
+			if (renderFrame) {
 				PrerenderBGLine();
 				PrerenderWindowLine();
 				PrerenderSPRLine();
 			}
-			break;
-		case PPUMode::Rendering:
-			if ((dot - 80) < screenWidth) {
-				if (dot % 8 == 0) SCX = (SCXBuffer & 0xf8) | (SCX & 0x07);
-				MergePixel();
-			}
-			else if (dot == (80 + mode3Penalty + screenWidth)) {
-				mode = PPUMode::HBlank;
-			}
-			break;
 		}
-
-		dot++;
-		if (dot == dotsPerScanline) {
-			dot = 0;
-			if (windowEnable && (WY <= LY) && (WX < 166)) windowScanline++;
-			LY++;
-			if (LY == scanlineCount) {
-				LY = 0;
-				windowScanline = 0;
-				activeFrame = (activeFrame + 1) % 2;
-				frameBuffers[activeFrame].Reset();
-				statInterruptionFlag = false;
-			}
+		break;
+	case PPUMode::Rendering:
+		if ((dot - 80) < screenWidth) {
+			ComposePixels(dot - 80, dot - 79);
+		}
+		else if (dot == (80 + mode3Penalty + screenWidth)) {
+			mode = PPUMode::HBlank;
+			if (renderFrame) DrawLine();
+			bus.dma.HBlank();
 		}
+		break;
+	}
 
-		LYCLY = (LY == LYC);
-		if (!statInterruptionFlag && LYCLY && LYCIntSelect) {
-			bus.TriggerInterruption(Interruption::LCD);
+	dot++;
+	if (dot == dotsPerScanline) {
+		dot = 0;
+		if (windowEnable && (WY <= LY) && (WX < 166)) windowScanline++;
+		LY++;
+		if (LY == scanlineCount) {
+			LY = 0;
+			windowScanline = 0;
+			StartFrame();
+			statInterruptionFlag = false;
 		}
+	}
 
-		UpdateStatInterruptionFlag();
+	LYCLY = (LY == LYC);
+	if (!statInterruptionFlag && LYCLY && LYCIntSelect) {
+		bus.TriggerInterruption(Interruption::LCD);
+	}
+
+	UpdateStatInterruptionFlag();
+}
+
+uint32_t PPU::CyclesUntilEvent() {
+	// Interruptions are only raised on the dot that changes mode or LY, or on the next dot
+	// after a STAT source was armed while the line was already running.
+	if (!statInterruptionFlag) {
+		bool armed = LYCIntSelect && LY == LYC;
+		switch (mode) {
+		case PPUMode::HBlank: armed |= mode0IntSelect; break;
+		case PPUMode::VBlank: armed |= mode1IntSelect; break;
+		case PPUMode::OAMScan: armed |= mode2IntSelect; break;
+		}
+		if (armed) return 1;
+	}
+	uint32_t eventDot = dotsPerScanline - 1;
+	if (mode == PPUMode::OAMScan && dot <= 79) {
+		eventDot = 79;
 	}
+	else if (mode == PPUMode::Rendering && dot <= 80 + mode3Penalty + screenWidth) {
+		eventDot = 80 + mode3Penalty + screenWidth;
+	}
+	return eventDot - dot + 1;
 }
 
 void PPU::DrawPixel() {
@@ -199,7 +295,7 @@ void PPU::DrawPixel() {
 			high = bus.Read8(0x9000 + (int8_t)tile * 16 + (y % 8) * 2 + 1);
 		}
 		bgPixel = ((low >> (7 - (x % 8))) & 1) | ((high >> (7 - (x % 8)) & 1) << 1);
-		frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[(BGP >> (bgPixel * 2)) & 0b11]);
+		frameBuffers[activeFrame].SetPixel(dot - 80, LY, lineColors.values[bgPixel]);
 		windowDrawn = true;
 	}
 	if (!windowDrawn && BGAndWindowPriority) {
@@ -219,7 +315,10 @@ void PPU::DrawPixel() {
 			high = bus.Read8(0x9000 + (int8_t)tile * 16 + (y % 8) * 2 + 1);
 		}
 		bgPixel = ((low >> (7 - (x % 8))) & 1) | ((high >> (7 - (x % 8)) & 1) << 1);
-		frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[(BGP >> (bgPixel * 2)) & 0b11]);
+		frameBuffers[activeFrame].SetPixel(dot - 80, LY, lineColors.values[bgPixel]);
+	}
+	else if (!windowDrawn) {
+		frameBuffers[activeFrame].SetPixel(dot - 80, LY, FrameBuffer::Pack(frameBuffers[activeFrame].format, 0, 0, 0));
 	}
 	if (OBJEnable) {
 		for (uint8_t spriteIndex = 0, objCount = 0, minX = 255; spriteIndex < 40 && objCount < 10; spriteIndex++) {
@@ -248,8 +347,7 @@ void PPU::DrawPixel() {
 			uint8_t high = bus.Read8(0x8000 + tileIndex * 16 + (row % 8) * 2 + 1);
 			uint8_t color = (((low >> (7 - col)) & 1) | ((high >> (7 - col)) & 1) << 1);
 			if (color == 0) continue;
-			uint8_t pal = sprite->DMGPalette ? OBP1 : OBP0;
-			frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[(pal >> (color * 2)) & 0b11]);
+			frameBuffers[activeFrame].SetPixel(dot - 80, LY, lineColors.values[4 + sprite->DMGPalette * 4 + color]);
 		}
 	}
 }
@@ -264,8 +362,8 @@ void PPU::DrawPatternTable(int32_t index) {
 			uint8_t low = bus.Read8(0x8000 + tile * 16 + (y % 8) * 2);
 			uint8_t high = bus.Read8(0x8000 + tile * 16 + (y % 8) * 2 + 1);
 			uint8_t value = ((low >> (7 - (x % 8))) & 1) | ((high >> (7 - (x % 8)) & 1) << 1);
-			float fValue = (float)value / 3.0f;
-			frameBuffers[activeFrame].SetPixel(x, y, { fValue, fValue, fValue });
+			uint8_t grey = value * 85;
+			frameBuffers[activeFrame].SetPixel(x, y, FrameBuffer::Pack(frameBuffers[activeFrame].format, grey, grey, grey, value));
 		}
 	}
 }
@@ -273,23 +371,15 @@ void PPU::DrawPatternTable(int32_t index) {
 void PPU::UpdateMode3Penalty() {
 	mode3Penalty = 12;
 	mode3Penalty += SCX % 8;
-	if (LY >= WY) mode3Penalty += 6;
-	std::vector<OAMEntry*> scanlineSprites;
-	for (int32_t i = 0; i < 40 && scanlineSprites.size() < 10; i++) {
-		OAMEntry* sprite = bus.GetOAMEntry(i);
-		uint16_t spriteY = sprite->y - 16;
-		if (LY < spriteY) continue;
-		uint16_t row = LY - spriteY;
-		if (OBJSize && row > 15) continue;
-		else if (row > 7) continue;
-		scanlineSprites.push_back(sprite);
-	}
-	for (int32_t i = 0; i < scanlineSprites.size(); i++) {
-		if (scanlineSprites[i]->x == 0) {
+	if (windowEnable && WY <= LY && WX < 166) mode3Penalty += 6;
+	const SpriteCache::Line& line = bus.mmc->spriteCache.GetLine(LY, OBJSize);
+	for (uint8_t i = 0; i < line.count; i++) {
+		OAMEntry* sprite = bus.GetOAMEntry(line.sprites[i]);
+		if (sprite->x == 0) {
 			mode3Penalty += 11;
 			continue;
 		}
-		mode3Penalty += 4 + (7 - ((scanlineSprites[i]->x - (SCX % 8)) % 8));
+		mode3Penalty += 4 + (7 - ((sprite->x - (SCX % 8)) % 8));
 	}
 }
 
@@ -387,7 +477,7 @@ void PPU::WriteSCX(uint8_t value) {
 }
 
 void PPU::WriteLY(uint8_t value) {
-	std::cout << "Warning: write to read only register LY\n";
+	CoreLog() << "Warning: write to read only register LY\n";
 }
 
 void PPU::WriteLYC(uint8_t value) {
@@ -397,16 +487,19 @@ void PPU::WriteLYC(uint8_t value) {
 void PPU::WriteBGP(uint8_t value) {
 	if (mode == PPUMode::Rendering) return;
 	BGP = value;
+	UpdatePaletteColors();
 }
 
 void PPU::WriteOBP0(uint8_t value) {
 	if (mode == PPUMode::Rendering) return;
 	OBP0 = value;
+	UpdatePaletteColors();
 }
 
 void PPU::WriteOBP1(uint8_t value) {
 	if (mode == PPUMode::Rendering) return;
 	OBP1 = value;
+	UpdatePaletteColors();
 }
 
 void PPU::WriteWY(uint8_t value) {
@@ -488,6 +581,32 @@ void PPU::LoadState(SaveState& state) {
 	OBPI = state.Read8();
 	OBPD = state.Read8();
 	OPRI = state.Read8();
+	renderFrame = true;
+	UpdatePaletteColors();
+}
+
+// Buffers are only swapped after a drawn frame, so the one the host reads always
+// holds the last complete frame.
+void PPU::StartFrame() {
+	if (renderFrame) activeFrame = (activeFrame + 1) % 2;
+	renderFrame = ShouldRenderFrame();
+}
+
+bool PPU::ShouldRenderFrame() {
+	switch (frameSkipMode) {
+	case FrameSkipMode::Fixed:
+		frameSkipCounter = (frameSkipCounter + 1) % frameSkipInterval;
+		return frameSkipCounter >= frameSkip;
+	case FrameSkipMode::Adaptive:
+		if (!frameReady || frameSkipCounter >= frameSkip) {
+			frameSkipCounter = 0;
+			return true;
+		}
+		frameSkipCounter++;
+		return false;
+	default:
+		return true;
+	}
 }
 
 void PPU::UpdateStatInterruptionFlag() {
@@ -500,113 +619,125 @@ void PPU::UpdateStatInterruptionFlag() {
 	}
 }
 
+void PPU::UpdatePaletteColors() {
+	PixelFormat format = frameBuffers[0].format;
+	uint32_t colors[4];
+	for (uint8_t shade = 0; shade < 4; shade++) {
+		colors[shade] = FrameBuffer::Pack(format, shadeColors[shade][0], shadeColors[shade][1], shadeColors[shade][2], shade);
+	}
+	lineColors.format = format;
+	for (uint8_t color = 0; color < 4; color++) {
+		lineColors.Set(color, colors[(BGP >> (color * 2)) & 0b11]);
+		lineColors.Set(4 + color, colors[(OBP0 >> (color * 2)) & 0b11]);
+		lineColors.Set(8 + color, colors[(OBP1 >> (color * 2)) & 0b11]);
+	}
+}
+
+// Tile numbers count from 0x8000, so the signed addressing mode maps to 128-383.
+uint32_t PPU::GetBGTileNumber(uint8_t tile) {
+	return BGAndWindowTileData ? tile : 256 + (int8_t)tile;
+}
+
 void PPU::PrerenderBGLine() {
-	memset(bgLinePixels.data(), 0, bgLinePixels.size() * sizeof(bgLinePixels[0]));
+	if (!BGAndWindowPriority) {
+		bgLinePixels.fill(0);
+		return;
+	}
 
+	uint32_t bank = bus.mmc->VBK & 1;
+	uint8_t y = LY + SCY;
+	const uint8_t* tileMap = bus.mmc->GetVRAMBank() + 0x1800 + 0x400 * BGTileMap + ((y & 0xf8) << 2);
 	for (uint32_t i = 0, x = 0; i < 32; i++, x += 8) {
-		if (BGAndWindowPriority) {
-			uint8_t y = LY + SCY;
-			uint16_t tileIndex = ((uint16_t)(y & 0xf8) << 2) + (x >> 3);
-			uint8_t tile = bus.Read8(0x9800 + tileIndex + 0x400 * BGTileMap);
-			uint8_t low = 0, high = 0;
-			if (BGAndWindowTileData) {
-				low = bus.Read8(0x8000 + tile * 16 + (y % 8) * 2);
-				high = bus.Read8(0x8000 + tile * 16 + (y % 8) * 2 + 1);
-			}
-			else {
-				low = bus.Read8(0x9000 + (int8_t)tile * 16 + (y % 8) * 2);
-				high = bus.Read8(0x9000 + (int8_t)tile * 16 + (y % 8) * 2 + 1);
-			}
-			for (uint8_t pixel = 0; pixel < 8; pixel++) {
-				bgLinePixels[x + pixel] = ((low >> (7 - pixel)) & 1) | ((high >> (7 - pixel) & 1) << 1);
-			}
-		}
+		memcpy(&bgLinePixels[x], bus.mmc->tileCache.GetRow(bank, GetBGTileNumber(tileMap[i]), y % 8, false), 8);
 	}
 }
 
 void PPU::PrerenderWindowLine() {
 	if (!windowEnable || WY > LY || WX >= 166) return;
-	memset(windowLinePixels.data(), 0, windowLinePixels.size() * sizeof(windowLinePixels[0]));
+	windowLinePixels.fill(0);
 
+	uint32_t bank = bus.mmc->VBK & 1;
+	uint8_t y = windowScanline;
+	const uint8_t* tileMap = bus.mmc->GetVRAMBank() + 0x1800 + 0x400 * windowTileMap + ((y & 0xf8) << 2);
 	for (uint32_t i = 0, x = 0; i < 20; i++, x += 8) {
-		uint8_t y = windowScanline;
-		uint16_t tileIndex = ((uint16_t)(y & 0xf8) << 2) + (x >> 3);
-		uint8_t tile = bus.Read8(0x9800 + tileIndex + 0x400 * windowTileMap);
-		uint8_t low = 0, high = 0;
-		if (BGAndWindowTileData) {
-			low = bus.Read8(0x8000 + tile * 16 + (y % 8) * 2);
-			high = bus.Read8(0x8000 + tile * 16 + (y % 8) * 2 + 1);
-		}
-		else {
-			low = bus.Read8(0x9000 + (int8_t)tile * 16 + (y % 8) * 2);
-			high = bus.Read8(0x9000 + (int8_t)tile * 16 + (y % 8) * 2 + 1);
-		}
-		for (uint8_t pixel = 0; pixel < 8; pixel++) {
-			windowLinePixels[x + pixel] = ((low >> (7 - pixel)) & 1) | ((high >> (7 - pixel) & 1) << 1);
-		}
+		memcpy(&windowLinePixels[x], bus.mmc->tileCache.GetRow(bank, GetBGTileNumber(tileMap[i]), y % 8, false), 8);
 	}
 }
 
 void PPU::PrerenderSPRLine() {
 	memset(sprLinePixels.data(), 0, sprLinePixels.size() * sizeof(sprLinePixels[0]));
 
-	for (uint8_t spriteIndex = 0, objCount = 0; spriteIndex < 40 && objCount < 10; spriteIndex++) {
-		OAMEntry* sprite = bus.GetOAMEntry(spriteIndex);
+	uint32_t bank = bus.mmc->VBK & 1;
+	const SpriteCache::Line& line = bus.mmc->spriteCache.GetLine(LY, OBJSize);
+	for (uint8_t i = 0; i < line.count; i++) {
+		OAMEntry* sprite = bus.GetOAMEntry(line.sprites[i]);
 		int16_t spriteX = sprite->x - 8;
-		int16_t spriteY = sprite->y - 16;
-		if (LY < spriteY) continue;
-		uint16_t row = LY - spriteY;
+		uint16_t row = LY - (sprite->y - 16);
 		uint16_t tileIndex = sprite->tile;
 		if (OBJSize) {
-			if (row > 15) continue;
 			if (sprite->yFlip) row = 15 - row;
 			tileIndex = (sprite->tile & 0xfe) + (row > 7);
 		}
 		else {
-			if (row > 7) continue;
 			if (sprite->yFlip) row = 7 - row;
 		}
-		objCount++;
-
-		uint8_t low = bus.Read8(0x8000 + tileIndex * 16 + (row % 8) * 2);
-		uint8_t high = bus.Read8(0x8000 + tileIndex * 16 + (row % 8) * 2 + 1);
-		uint8_t pal = sprite->DMGPalette ? OBP1 : OBP0;
-
-		if (sprite->xFlip) {
-			for (uint8_t pixelX = 7, x = 0; x < 8; pixelX--, x++) {
-				if ((spriteX + x) >= sprLinePixels.size() || (sprLinePixels[spriteX + x] & 0b11) != 0) continue;
-				uint8_t color = (((low >> (7 - pixelX)) & 1) | ((high >> (7 - pixelX)) & 1) << 1);
-				if (color == 0) continue;
-				sprLinePixels[spriteX + x] = (sprite->priority << 2) | color | (pal << 8);// palette[(pal >> (color * 2)) & 0b11];
-			}
-		}
-		else {
-			for (uint8_t pixelX = 0; pixelX < 8; pixelX++) {
-				if ((spriteX + pixelX) >= sprLinePixels.size() || (sprLinePixels[spriteX + pixelX] & 0b11) != 0) continue;
-				uint8_t color = (((low >> (7 - pixelX)) & 1) | ((high >> (7 - pixelX)) & 1) << 1);
-				if (color == 0) continue;
-				sprLinePixels[spriteX + pixelX] = (sprite->priority << 2) | color | (pal << 8); // palette[(pal >> (color * 2)) & 0b11];
-			}
+
+		const uint8_t* pixels = bus.mmc->tileCache.GetRow(bank, tileIndex, row % 8, sprite->xFlip);
+		uint8_t attributes = (sprite->priority << 7) | (4 + sprite->DMGPalette * 4);
+		for (uint8_t x = 0; x < 8; x++) {
+			if ((spriteX + x) >= sprLinePixels.size() || sprLinePixels[spriteX + x] != 0) continue;
+			uint8_t color = pixels[x];
+			if (color == 0) continue;
+			sprLinePixels[spriteX + x] = attributes | color;
 		}
 	}
 }
 
-void PPU::MergePixel() {
+// Composes pixels [x, end) of the line into palette indices. Register writes
+// catch the PPU up first, so the registers are constant over the span and the
+// line is drawn in runs instead of dot by dot. Skipped frames only latch SCX,
+// which the ROM can read back.
+void PPU::ComposePixels(uint32_t x, uint32_t end) {
+	if (x % 8) {
+		uint32_t next = std::min(end, (x | 7) + 1);
+		if (renderFrame) ComposeRun(x, next);
+		x = next;
+	}
+	if (x < end) {
+		// The coarse scroll is latched at every tile; it can only change between spans.
+		SCX = (SCXBuffer & 0xf8) | (SCX & 0x07);
+		if (renderFrame) ComposeRun(x, end);
+	}
+}
 
-	if (windowEnable && WY <= LY && WX < 160 && (dot - 73) >= WX) {
-		if (OBJEnable && (sprLinePixels[dot - 80] & 0b11) != 0 && (!((sprLinePixels[dot - 80] >> 2) & 1) || !windowLinePixels[(dot - 73) - WX])) {
-			frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[((sprLinePixels[dot - 80] >> 8) >> ((sprLinePixels[dot - 80] & 0b11) * 2)) & 0b11]);
-		}
-		else {
-			frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[(BGP >> (windowLinePixels[(dot - 73) - WX] * 2)) & 0b11]);
-		}
+void PPU::ComposeRun(uint32_t x, uint32_t end) {
+	uint32_t windowStart = screenWidth;
+	if (windowEnable && WY <= LY && WX < screenWidth) windowStart = WX > 7 ? WX - 7 : 0;
+
+	for (uint32_t i = x; i < std::min(end, windowStart);) {
+		uint32_t source = (i + SCX) % bgLinePixels.size();
+		uint32_t count = std::min<uint32_t>(std::min(end, windowStart) - i, (uint32_t)bgLinePixels.size() - source);
+		memcpy(&linePixels[i], &bgLinePixels[source], count);
+		i += count;
 	}
-	else {
-		if (OBJEnable && (sprLinePixels[dot - 80] & 0b11) != 0 && (!((sprLinePixels[dot - 80] >> 2) & 1) || !bgLinePixels[(dot - 80 + SCX) % bgLinePixels.size()])) {
-			frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[((sprLinePixels[dot - 80] >> 8) >> ((sprLinePixels[dot - 80] & 0b11) * 2)) & 0b11]);
-		}
-		else {
-			frameBuffers[activeFrame].SetPixel(dot - 80, LY, palette[(BGP >> (bgLinePixels[(dot - 80 + SCX) % bgLinePixels.size()] * 2)) & 0b11]);
-		}
+	if (end > windowStart) {
+		uint32_t first = std::max(x, windowStart);
+		memcpy(&linePixels[first], &windowLinePixels[first + 7 - WX], end - first);
 	}
-}
\ No newline at end of file
+	if (!OBJEnable) return;
+
+	// Sprite pixels win unless they are transparent, or behind a non-zero BG color.
+	for (uint32_t i = x; i < end; i++) {
+		uint8_t background = linePixels[i];
+		uint8_t sprite = sprLinePixels[i];
+		uint8_t color = sprite & 0x0f;
+		bool visible = color != 0 && !((sprite >> 7) & (background != 0));
+		linePixels[i] = visible ? color : background;
+	}
+}
+
+void PPU::DrawLine() {
+	if (LY >= screenHeight) return;
+	FrameBuffer& frame = frameBuffers[activeFrame];
+	PixelKernels::Get().expandPalette(linePixels.data(), screenWidth, lineColors, &frame.pixels[LY * frame.width * FrameBuffer::BytesPerPixel(frame.format)]);
+}
@@ -1,7 +1,8 @@
 #pragma once
 #include <cstdint>
 #include "Bus.h"
-#include "Texture.h"
+#include "FrameBuffer.h"
+#include "PixelKernels.h"
 
 class Bus;
 
@@ -12,6 +13,16 @@ enum PPUMode {
 	Rendering = 3,
 };
 
+// Frames whose pixels aren't drawn. The PPU still keeps modes, LY, STAT and
+// interruptions on time, so the ROM can't tell. Fixed skips the first n of every
+// m frames (n below m), Adaptive skips frames while the host hasn't taken the last drawn one
+// (frameReady is still set), but no more than n in a row.
+enum class FrameSkipMode {
+	Off,
+	Fixed,
+	Adaptive,
+};
+
 class PPU {
 public:
 	static const uint32_t scanlineCount = 154;
@@ -20,16 +31,21 @@ public:
 	static const uint32_t screenHeight = 144;
 
 	uint8_t activeFrame = 0;
-	Texture<Color> frameBuffers[2] = {
-		Texture<Color>(screenWidth, screenHeight),
-		Texture<Color>(screenWidth, screenHeight)
+	FrameBuffer frameBuffers[2] = {
+		FrameBuffer(screenWidth, screenHeight),
+		FrameBuffer(screenWidth, screenHeight)
 	};
+	// 8-bit RGB of the four DMG shades, lightest first.
+	static const uint8_t shadeColors[4][3];
 
 	PPU(Bus& bus);
 
 	void Reset();
+	void SetPixelFormat(PixelFormat format);
+	void SetFrameSkip(FrameSkipMode mode, uint32_t skip, uint32_t interval);
 	void StepPixelMode(uint32_t cycles);
 	void StepScanlineMode(uint32_t cycles);
+	uint32_t CyclesUntilEvent();
 
 	void DrawPatternTable(int32_t index);
 
@@ -74,7 +90,13 @@ public:
 	uint16_t dot = 0;
 	uint8_t mode3Penalty = 12;
 	uint8_t windowScanline = 0;
+	// Set when a drawn frame is complete; skipped frames leave the last one in place.
 	bool frameReady = false;
+	bool renderFrame = true;
+	FrameSkipMode frameSkipMode = FrameSkipMode::Off;
+	uint32_t frameSkip = 0;
+	uint32_t frameSkipInterval = 1;
+	uint32_t frameSkipCounter = 0;
 	bool statInterruptionFlag = false;
 
 	union {
@@ -118,16 +140,34 @@ public:
 	uint8_t OPRI = 0xff;
 
 	std::array<uint8_t, 256> bgLinePixels;
-	std::array<uint8_t, 166> windowLinePixels;
-	std::array<uint16_t, screenWidth> sprLinePixels;
+	// Window pixels from WX - 7, with room for WX below 7 reading past the line.
+	std::array<uint8_t, screenWidth + 8> windowLinePixels;
+	// Palette index of the sprite pixel on top (0 if none), bit 7 set when it is behind BG colors 1-3.
+	std::array<uint8_t, screenWidth> sprLinePixels;
+	// Palette index of every pixel of the line being drawn: BG colors 0-3, then
+	// OBP0 and OBP1 colors 4-11. The line is converted to packed pixels at once
+	// when it ends.
+	std::array<uint8_t, screenWidth> linePixels = {};
+	// Packed pixel values of those indices, rebuilt when a palette or the pixel
+	// format changes.
+	PaletteTable lineColors;
 
 	void DrawPixel();
 	void UpdateMode3Penalty();
+	uint32_t GetBGTileNumber(uint8_t tile);
 	void PrerenderBGLine();
 	void PrerenderWindowLine();
 	void PrerenderSPRLine();
-	void MergePixel();
+	void ComposePixels(uint32_t x, uint32_t end);
+	void ComposeRun(uint32_t x, uint32_t end);
+	void DrawLine();
+	uint32_t QuietDots();
+	void SkipQuietDots(uint32_t dots);
+	void StepScanlineDot();
+	void StartFrame();
+	bool ShouldRenderFrame();
 	void UpdateStatInterruptionFlag();
+	void UpdatePaletteColors();
 
 	friend class Bus;
 	friend class GBCEmulator;
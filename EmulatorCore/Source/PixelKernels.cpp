@@ -0,0 +1,214 @@
+#include "PixelKernels.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef GBC_X86_KERNELS
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit vector instructions in functions built for them.
+#ifdef __GNUC__
+#define GBC_TARGET(features) __attribute__((target(features)))
+#else
+#define GBC_TARGET(features)
+#endif
+
+void PaletteTable::Set(uint32_t index, uint32_t value) {
+	values[index] = value;
+	uint8_t bytes[4] = {};
+	switch (format) {
+	case PixelFormat::RGBA8: memcpy(bytes, &value, 4); break;
+	case PixelFormat::RGB565: {
+		uint16_t packed = (uint16_t)value;
+		memcpy(bytes, &packed, 2);
+		break;
+	}
+	default: bytes[0] = (uint8_t)value; break;
+	}
+	for (uint32_t plane = 0; plane < 4; plane++) {
+		planes[plane][index] = bytes[plane];
+	}
+}
+
+static void DecodeTileScalar(const uint8_t* data, uint8_t* pixels, uint8_t* flipped) {
+	for (uint32_t row = 0; row < 8; row++) {
+		uint8_t low = data[row * 2];
+		uint8_t high = data[row * 2 + 1];
+		for (uint32_t x = 0; x < 8; x++) {
+			uint8_t color = ((low >> (7 - x)) & 1) | (((high >> (7 - x)) & 1) << 1);
+			pixels[row * 8 + x] = color;
+			flipped[row * 8 + 7 - x] = color;
+		}
+	}
+}
+
+static void ExpandPaletteScalar(const uint8_t* indices, uint32_t count, const PaletteTable& palette, uint8_t* out) {
+	switch (palette.format) {
+	case PixelFormat::RGBA8:
+		for (uint32_t i = 0; i < count; i++) {
+			memcpy(&out[i * 4], &palette.values[indices[i]], 4);
+		}
+		break;
+	case PixelFormat::RGB565:
+		for (uint32_t i = 0; i < count; i++) {
+			uint16_t packed = (uint16_t)palette.values[indices[i]];
+			memcpy(&out[i * 2], &packed, 2);
+		}
+		break;
+	default:
+		for (uint32_t i = 0; i < count; i++) {
+			out[i] = (uint8_t)palette.values[indices[i]];
+		}
+		break;
+	}
+}
+
+#ifdef GBC_X86_KERNELS
+// Two rows per register: each plane byte is broadcast over the eight pixels of
+// its row and compared against the pixel's bit.
+GBC_TARGET("ssse3") static void DecodeTileSSSE3(const uint8_t* data, uint8_t* pixels, uint8_t* flipped) {
+	const __m128i tile = _mm_loadu_si128((const __m128i*)data);
+	const __m128i bits = _mm_setr_epi8((char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, (char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+	const __m128i mirroredBits = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80);
+	const __m128i one = _mm_set1_epi8(1);
+	const __m128i two = _mm_set1_epi8(2);
+	const __m128i nextRows = _mm_set1_epi8(4);
+	__m128i lowBytes = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2);
+	__m128i highBytes = _mm_setr_epi8(1, 1, 1, 1, 1, 1, 1, 1, 3, 3, 3, 3, 3, 3, 3, 3);
+	for (uint32_t row = 0; row < 8; row += 2) {
+		const __m128i low = _mm_shuffle_epi8(tile, lowBytes);
+		const __m128i high = _mm_shuffle_epi8(tile, highBytes);
+		lowBytes = _mm_add_epi8(lowBytes, nextRows);
+		highBytes = _mm_add_epi8(highBytes, nextRows);
+		__m128i colors = _mm_or_si128(
+			_mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(low, bits), bits), one),
+			_mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(high, bits), bits), two));
+		__m128i mirrored = _mm_or_si128(
+			_mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(low, mirroredBits), mirroredBits), one),
+			_mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(high, mirroredBits), mirroredBits), two));
+		_mm_storeu_si128((__m128i*)&pixels[row * 8], colors);
+		_mm_storeu_si128((__m128i*)&flipped[row * 8], mirrored);
+	}
+}
+
+// One PSHUFB per byte plane looks up 16 pixels, and unpacking the planes
+// interleaves them into packed pixels.
+GBC_TARGET("ssse3") static void ExpandPaletteSSSE3(const uint8_t* indices, uint32_t count, const PaletteTable& palette, uint8_t* out) {
+	const __m128i plane0 = _mm_load_si128((const __m128i*)palette.planes[0]);
+	const __m128i plane1 = _mm_load_si128((const __m128i*)palette.planes[1]);
+	const __m128i plane2 = _mm_load_si128((const __m128i*)palette.planes[2]);
+	const __m128i plane3 = _mm_load_si128((const __m128i*)palette.planes[3]);
+	uint32_t bytesPerPixel = FrameBuffer::BytesPerPixel(palette.format);
+	uint32_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m128i index = _mm_loadu_si128((const __m128i*)&indices[i]);
+		__m128i bytes0 = _mm_shuffle_epi8(plane0, index);
+		uint8_t* destination = &out[i * bytesPerPixel];
+		if (bytesPerPixel == 1) {
+			_mm_storeu_si128((__m128i*)destination, bytes0);
+			continue;
+		}
+		__m128i bytes1 = _mm_shuffle_epi8(plane1, index);
+		__m128i low01 = _mm_unpacklo_epi8(bytes0, bytes1);
+		__m128i high01 = _mm_unpackhi_epi8(bytes0, bytes1);
+		if (bytesPerPixel == 2) {
+			_mm_storeu_si128((__m128i*)destination, low01);
+			_mm_storeu_si128((__m128i*)(destination + 16), high01);
+			continue;
+		}
+		__m128i bytes2 = _mm_shuffle_epi8(plane2, index);
+		__m128i bytes3 = _mm_shuffle_epi8(plane3, index);
+		__m128i low23 = _mm_unpacklo_epi8(bytes2, bytes3);
+		__m128i high23 = _mm_unpackhi_epi8(bytes2, bytes3);
+		_mm_storeu_si128((__m128i*)destination, _mm_unpacklo_epi16(low01, low23));
+		_mm_storeu_si128((__m128i*)(destination + 16), _mm_unpackhi_epi16(low01, low23));
+		_mm_storeu_si128((__m128i*)(destination + 32), _mm_unpacklo_epi16(high01, high23));
+		_mm_storeu_si128((__m128i*)(destination + 48), _mm_unpackhi_epi16(high01, high23));
+	}
+	ExpandPaletteScalar(&indices[i], count - i, palette, &out[i * bytesPerPixel]);
+}
+
+// 32 pixels at a time. Unpacks stay inside 128-bit lanes, so the second half of
+// every lane is moved into place when storing.
+GBC_TARGET("avx2") static void ExpandPaletteAVX2(const uint8_t* indices, uint32_t count, const PaletteTable& palette, uint8_t* out) {
+	const __m256i plane0 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)palette.planes[0]));
+	const __m256i plane1 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)palette.planes[1]));
+	const __m256i plane2 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)palette.planes[2]));
+	const __m256i plane3 = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)palette.planes[3]));
+	uint32_t bytesPerPixel = FrameBuffer::BytesPerPixel(palette.format);
+	uint32_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i index = _mm256_loadu_si256((const __m256i*)&indices[i]);
+		__m256i bytes0 = _mm256_shuffle_epi8(plane0, index);
+		uint8_t* destination = &out[i * bytesPerPixel];
+		if (bytesPerPixel == 1) {
+			_mm256_storeu_si256((__m256i*)destination, bytes0);
+			continue;
+		}
+		__m256i bytes1 = _mm256_shuffle_epi8(plane1, index);
+		__m256i low01 = _mm256_unpacklo_epi8(bytes0, bytes1);
+		__m256i high01 = _mm256_unpackhi_epi8(bytes0, bytes1);
+		if (bytesPerPixel == 2) {
+			_mm256_storeu_si256((__m256i*)destination, _mm256_permute2x128_si256(low01, high01, 0x20));
+			_mm256_storeu_si256((__m256i*)(destination + 32), _mm256_permute2x128_si256(low01, high01, 0x31));
+			continue;
+		}
+		__m256i bytes2 = _mm256_shuffle_epi8(plane2, index);
+		__m256i bytes3 = _mm256_shuffle_epi8(plane3, index);
+		__m256i low23 = _mm256_unpacklo_epi8(bytes2, bytes3);
+		__m256i high23 = _mm256_unpackhi_epi8(bytes2, bytes3);
+		__m256i pixels0 = _mm256_unpacklo_epi16(low01, low23);
+		__m256i pixels4 = _mm256_unpackhi_epi16(low01, low23);
+		__m256i pixels8 = _mm256_unpacklo_epi16(high01, high23);
+		__m256i pixels12 = _mm256_unpackhi_epi16(high01, high23);
+		_mm256_storeu_si256((__m256i*)destination, _mm256_permute2x128_si256(pixels0, pixels4, 0x20));
+		_mm256_storeu_si256((__m256i*)(destination + 32), _mm256_permute2x128_si256(pixels8, pixels12, 0x20));
+		_mm256_storeu_si256((__m256i*)(destination + 64), _mm256_permute2x128_si256(pixels0, pixels4, 0x31));
+		_mm256_storeu_si256((__m256i*)(destination + 96), _mm256_permute2x128_si256(pixels8, pixels12, 0x31));
+	}
+	ExpandPaletteScalar(&indices[i], count - i, palette, &out[i * bytesPerPixel]);
+}
+#endif
+
+static const PixelKernels kernels[] = {
+	{ SIMDLevel::Scalar, "scalar", DecodeTileScalar, ExpandPaletteScalar },
+#ifdef GBC_X86_KERNELS
+	{ SIMDLevel::SSSE3, "ssse3", DecodeTileSSSE3, ExpandPaletteSSSE3 },
+	// Tile decode stays on SSSE3: PDEP would only be slightly faster where it is
+	// fast, and it is microcoded on AMD before Zen 3.
+	{ SIMDLevel::AVX2, "avx2", DecodeTileSSSE3, ExpandPaletteAVX2 },
+#endif
+};
+
+SIMDLevel PixelKernels::GetHostLevel() {
+#if defined(GBC_X86_KERNELS) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return SIMDLevel::AVX2;
+	if (__builtin_cpu_supports("ssse3")) return SIMDLevel::SSSE3;
+#elif defined(GBC_X86_KERNELS) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int leafCount = info[0];
+	__cpuid(info, 1);
+	bool ssse3 = info[2] & (1 << 9);
+	// AVX registers also need OS support, reported through OSXSAVE and XCR0.
+	bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0b110) == 0b110;
+	if (avx && leafCount >= 7) {
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5)) return SIMDLevel::AVX2;
+	}
+	if (ssse3) return SIMDLevel::SSSE3;
+#endif
+	return SIMDLevel::Scalar;
+}
+
+const PixelKernels& PixelKernels::Get(SIMDLevel level) {
+	level = std::min(level, GetHostLevel());
+	for (const PixelKernels& candidate : kernels) {
+		if (candidate.level == level) return candidate;
+	}
+	return kernels[0];
+}
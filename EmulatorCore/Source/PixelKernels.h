@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include "FrameBuffer.h"
+
+// Vector kernels need an x86-64 host; elsewhere only the scalar versions exist.
+#if defined(__x86_64__) || defined(_M_X64)
+#define GBC_X86_KERNELS
+#endif
+
+enum class SIMDLevel {
+	Scalar,
+	SSSE3,
+	AVX2,
+};
+
+// Up to 16 packed pixel values, also split into byte planes so a PSHUFB can
+// look up one byte of 16 pixels at once.
+struct PaletteTable {
+	static const uint32_t Size = 16;
+
+	PixelFormat format = PixelFormat::RGBA8;
+	std::array<uint32_t, Size> values = {};
+	alignas(16) uint8_t planes[4][Size] = {};
+
+	void Set(uint32_t index, uint32_t value);
+};
+
+// Hot loops of the PPU, picked once for the host CPU. Every level produces the
+// same bytes as the scalar kernels.
+struct PixelKernels {
+	SIMDLevel level;
+	const char* name;
+	// 16 bytes of 2bpp tile data to 64 color numbers, and the same rows mirrored.
+	void (*decodeTile)(const uint8_t* data, uint8_t* pixels, uint8_t* flipped);
+	// Pixels of count palette indices (below 16) in the table's format.
+	void (*expandPalette)(const uint8_t* indices, uint32_t count, const PaletteTable& palette, uint8_t* out);
+
+	static SIMDLevel GetHostLevel();
+	static const PixelKernels& Get(SIMDLevel level);
+	static const PixelKernels& Get() {
+		static const PixelKernels& kernels = Get(GetHostLevel());
+		return kernels;
+	}
+};
@@ -0,0 +1,116 @@
+#include "ROMImage.h"
+#include "MMC.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static std::mutex openImagesMutex;
+static std::unordered_map<std::string, std::weak_ptr<const ROMImage>> openImages;
+
+ROMImage::~ROMImage() {
+	Unmap();
+}
+
+std::shared_ptr<const ROMImage> ROMImage::Open(const std::string& path) {
+	std::error_code error;
+	std::string key = std::filesystem::weakly_canonical(path, error).string();
+	if (error) key = path;
+
+	std::lock_guard<std::mutex> lock(openImagesMutex);
+	std::shared_ptr<const ROMImage> image = openImages[key].lock();
+	if (image) return image;
+
+	std::shared_ptr<ROMImage> newImage(new ROMImage());
+	if (!newImage->Map(path)) {
+		std::ifstream reader(path, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!reader) return nullptr;
+		std::vector<uint8_t> file((size_t)reader.tellg());
+		reader.seekg(0, reader.beg);
+		reader.read((char*)file.data(), file.size());
+		if (!reader || file.size() < MinSize) return nullptr;
+		newImage->CopyFrom(file.data(), (uint32_t)file.size());
+	}
+	openImages[key] = newImage;
+	return newImage;
+}
+
+std::shared_ptr<const ROMImage> ROMImage::FromMemory(const uint8_t* data, uint32_t size) {
+	if (!data || size < MinSize) return nullptr;
+	std::shared_ptr<ROMImage> image(new ROMImage());
+	image->CopyFrom(data, size);
+	return image;
+}
+
+// Maps the file read-only. Files shorter than their header size are copied and
+// padded instead, because the missing tail of a mapping would read as zeros.
+bool ROMImage::Map(const std::string& path) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(file, &length) || length.QuadPart < MinSize || length.QuadPart > UINT32_MAX) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!fileMapping) return false;
+	void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(fileMapping);
+	if (!view) return false;
+	mappingSize = (uint32_t)length.QuadPart;
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) return false;
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size < MinSize || status.st_size > UINT32_MAX) {
+		close(file);
+		return false;
+	}
+	void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (view == MAP_FAILED) return false;
+	mappingSize = (uint32_t)status.st_size;
+#endif
+	mapping = view;
+	data = (const uint8_t*)mapping;
+	fileSize = mappingSize;
+	size = MMC::GetROMSize(data, fileSize);
+	if (fileSize < size) {
+		std::vector<uint8_t> file(data, data + fileSize);
+		Unmap();
+		CopyFrom(file.data(), (uint32_t)file.size());
+	}
+	return true;
+}
+
+void ROMImage::CopyFrom(const uint8_t* source, uint32_t sourceSize) {
+	fileSize = sourceSize;
+	size = MMC::GetROMSize(source, sourceSize);
+	buffer.assign(std::max(size, sourceSize), 0xff);
+	std::copy(source, source + sourceSize, buffer.begin());
+	data = buffer.data();
+}
+
+void ROMImage::Unmap() {
+	if (!mapping) return;
+#ifdef _WIN32
+	UnmapViewOfFile(mapping);
+#else
+	munmap(mapping, mappingSize);
+#endif
+	mapping = nullptr;
+	mappingSize = 0;
+	data = nullptr;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only cartridge image. Files are memory mapped and shared: opening the same
+// path again while an image is alive returns the same image, so every instance
+// running a cartridge maps its banks straight into one copy of the ROM.
+class ROMImage {
+public:
+	// Smallest image that holds a cartridge header.
+	static const uint32_t MinSize = 0x150;
+
+	~ROMImage();
+
+	static std::shared_ptr<const ROMImage> Open(const std::string& path);
+	static std::shared_ptr<const ROMImage> FromMemory(const uint8_t* data, uint32_t size);
+
+	const uint8_t* GetData() const { return data; }
+	// Size of the banked ROM, at least the size from the header. Missing banks read 0xff.
+	uint32_t GetSize() const { return size; }
+	// Size of the file or buffer the image was made from.
+	uint32_t GetFileSize() const { return fileSize; }
+	bool IsMapped() const { return mapping != nullptr; }
+
+private:
+	const uint8_t* data = nullptr;
+	uint32_t size = 0;
+	uint32_t fileSize = 0;
+	void* mapping = nullptr;
+	uint32_t mappingSize = 0;
+	std::vector<uint8_t> buffer;
+
+	ROMImage() = default;
+	bool Map(const std::string& path);
+	void CopyFrom(const uint8_t* data, uint32_t size);
+	void Unmap();
+};
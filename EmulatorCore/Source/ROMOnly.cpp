@@ -0,0 +1,29 @@
+#include "ROMOnly.h"
+#include "Bus.h"
+#include <algorithm>
+
+ROMOnly::ROMOnly(Bus& bus) : MapperBase(bus) {}
+
+void ROMOnly::LoadROM(std::shared_ptr<const ROMImage> image) {
+	AttachROM(image);
+	// Carts without a mapper may still wire up a RAM chip, so always provide one bank.
+	eram.assign(std::max(GetRAMSize(rom), RAMBankSize), 0);
+	UpdateMemoryMap();
+}
+
+uint8_t ROMOnly::ReadCartridge(uint16_t address) {
+	if (address < 0x8000) {
+		return address < romSize ? rom[address] : 0xff;
+	}
+	return eram.empty() ? 0xff : eram[address - 0xa000];
+}
+
+void ROMOnly::WriteCartridge(uint16_t address, uint8_t value) {
+	if (address >= 0xa000 && !eram.empty()) {
+		eram[address - 0xa000] = value;
+	}
+}
+
+void ROMOnly::MapBanks() {
+	MapCartridge(rom, rom ? rom + ROMBankSize : nullptr, eram.empty() ? nullptr : eram.data());
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "MMC.h"
+
+class Bus;
+
+// Cartridges without a mapper: two fixed ROM banks and an optional RAM chip.
+// Also stands in for mapper types that aren't emulated.
+class ROMOnly : public MapperBase<ROMOnly> {
+public:
+	ROMOnly(Bus& bus);
+
+	void LoadROM(std::shared_ptr<const ROMImage> image);
+
+private:
+	uint8_t ReadCartridge(uint16_t address);
+	void WriteCartridge(uint16_t address, uint8_t value);
+	void MapBanks();
+	void ResetRegisters() {}
+	void WriteRegisters(SaveState&) {}
+	void LoadRegisters(SaveState&) {}
+
+	friend class MapperBase<ROMOnly>;
+};
@@ -1,6 +1,8 @@
 #include "SPU.h"
+#include "Log.h"
+#include <climits>
 
-std::array<uint16_t, 4> dutyCycles = {
+static const std::array<uint16_t, 4> dutyCycles = {
 	0b11111110'11111110,
 	0b01111110'01111110,
 	0b01111000'01111000,
@@ -13,6 +15,7 @@ SPU::SPU(Bus& bus) : bus(bus) {
 
 void SPU::Reset() {
 	clockAccumulator = 0;
+	synchronizedCycle = 0;
 	sampleCounter = 0;
 	for (uint32_t i = 0; i < 5; i++) {
 		sweepChannel.WriteRegister(i, 0);
@@ -40,6 +43,13 @@ int16_t* SPU::GetSamples() {
 	return samples.data();
 }
 
+void SPU::Synchronize() {
+	uint64_t now = bus.scheduler.Now();
+	if (now == synchronizedCycle) return;
+	Step((uint32_t)(now - synchronizedCycle));
+	synchronizedCycle = now;
+}
+
 void SPU::Step(uint32_t cpuClocks) {
 	const int16_t scale = SHRT_MAX / 4;
 	clockAccumulator += cpuClocks;
@@ -124,7 +134,7 @@ uint8_t SPU::ToneChannel::ReadRegister(uint8_t reg) {
 	case 4:
 		return uselen << 6;
 	default:
-		std::cout << "Read from out of range tone or sweep channel register.\n";
+		CoreLog() << "Read from out of range tone or sweep channel register.\n";
 		return 0xff;
 	}
 }
@@ -158,7 +168,7 @@ void SPU::ToneChannel::WriteRegister(uint8_t reg, uint8_t value) {
 		}
 		break;
 	default:
-		std::cout << "Write to out of range tone or seep channel register.\n";
+		CoreLog() << "Write to out of range tone or seep channel register.\n";
 	}
 }
 
@@ -282,7 +292,7 @@ uint8_t SPU::WaveChannel::ReadRegister(uint8_t reg) {
 	case 4:
 		return (uselen << 6) | 0xbf;
 	default:
-		std::cout << "Read from out of range wave channel register.\n";
+		CoreLog() << "Read from out of range wave channel register.\n";
 		return 0xff;
 	}
 }
@@ -316,7 +326,7 @@ void SPU::WaveChannel::WriteRegister(uint8_t reg, uint8_t value) {
 		}
 		break;
 	default:
-		std::cout << "Write to out of range wave channel register.\n";
+		CoreLog() << "Write to out of range wave channel register.\n";
 	}
 }
 
@@ -387,7 +397,7 @@ uint8_t SPU::NoiseChannel::ReadRegister(uint8_t reg) {
 	case 4:
 		return uselen << 6 | 0xbf;
 	default:
-		std::cout << "Read from out of range noise channel register.\n";
+		CoreLog() << "Read from out of range noise channel register.\n";
 		return 0xff;
 	}
 }
@@ -421,7 +431,7 @@ void SPU::NoiseChannel::WriteRegister(uint8_t reg, uint8_t value) {
 		}
 		break;
 	default:
-		std::cout << "Write to out of range noise channel register.\n";
+		CoreLog() << "Write to out of range noise channel register.\n";
 	}
 }
 
@@ -18,6 +18,9 @@ public:
 	int16_t* GetSamples();
 
 	void Step(uint32_t cpuClocks);
+	// Synthesizes samples up to the scheduler's current cycle. Called before
+	// SPU register accesses and at the end of every run, not per instruction.
+	void Synchronize();
 
 	void WriteState(SaveState& state);
 	void LoadState(uint8_t* state);
@@ -25,6 +28,7 @@ public:
 	Bus& bus;
 
 	double clockAccumulator;
+	uint64_t synchronizedCycle = 0;
 	uint32_t tickCounter;
 	uint32_t sampleCounter;
 
@@ -0,0 +1,75 @@
+#include "Scheduler.h"
+
+Scheduler::Scheduler() {
+	Reset();
+}
+
+void Scheduler::Reset() {
+	now = 0;
+	synchronized = 0;
+	size = 0;
+	positions.fill(-1);
+	UpdateNextDeadline();
+}
+
+void Scheduler::Schedule(SchedulerEvent event, uint64_t timestamp) {
+	int32_t index = positions[(size_t)event];
+	if (index < 0) {
+		index = size++;
+		heap[index] = { timestamp, event };
+		positions[(size_t)event] = index;
+		SiftUp(index);
+	}
+	else {
+		uint64_t previous = heap[index].timestamp;
+		heap[index].timestamp = timestamp;
+		if (timestamp < previous) SiftUp(index);
+		else SiftDown(index);
+	}
+	UpdateNextDeadline();
+}
+
+void Scheduler::Deschedule(SchedulerEvent event) {
+	int32_t index = positions[(size_t)event];
+	if (index < 0) return;
+	size--;
+	if ((uint32_t)index != size) {
+		Swap(index, size);
+		SiftUp(index);
+		SiftDown(positions[(size_t)heap[index].event]);
+	}
+	positions[(size_t)event] = -1;
+	UpdateNextDeadline();
+}
+
+void Scheduler::Swap(uint32_t a, uint32_t b) {
+	std::swap(heap[a], heap[b]);
+	positions[(size_t)heap[a].event] = a;
+	positions[(size_t)heap[b].event] = b;
+}
+
+void Scheduler::SiftUp(uint32_t index) {
+	while (index > 0) {
+		uint32_t parent = (index - 1) / 2;
+		if (heap[parent].timestamp <= heap[index].timestamp) break;
+		Swap(parent, index);
+		index = parent;
+	}
+}
+
+void Scheduler::SiftDown(uint32_t index) {
+	while (true) {
+		uint32_t smallest = index;
+		uint32_t left = index * 2 + 1;
+		uint32_t right = left + 1;
+		if (left < size && heap[left].timestamp < heap[smallest].timestamp) smallest = left;
+		if (right < size && heap[right].timestamp < heap[smallest].timestamp) smallest = right;
+		if (smallest == index) break;
+		Swap(smallest, index);
+		index = smallest;
+	}
+}
+
+void Scheduler::UpdateNextDeadline() {
+	nextDeadline = size ? heap[0].timestamp : Never;
+}
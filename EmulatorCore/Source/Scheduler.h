@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <utility>
+
+enum class SchedulerEvent {
+	TimerOverflow = 0,
+	PPUModeChange,
+	DMATransfer,
+	COUNT
+};
+
+// Min-heap of component deadlines in CPU cycles. The CPU runs until the
+// earliest deadline, then the bus brings every component up to date.
+class Scheduler {
+public:
+	static const uint64_t Never = UINT64_MAX;
+
+	Scheduler();
+
+	void Reset();
+	void Schedule(SchedulerEvent event, uint64_t timestamp);
+	void Deschedule(SchedulerEvent event);
+
+	uint64_t Now() const { return now; }
+	uint64_t NextDeadline() const { return nextDeadline; }
+	SchedulerEvent NextEvent() const { return heap[0].event; }
+	uint32_t PendingCycles() const { return (uint32_t)(now - synchronized); }
+
+	bool DeadlineReached() const { return now >= nextDeadline; }
+
+	bool Advance(uint32_t cycles) {
+		now += cycles;
+		return DeadlineReached();
+	}
+
+	uint32_t TakePendingCycles() {
+		uint32_t cycles = PendingCycles();
+		synchronized = now;
+		return cycles;
+	}
+
+private:
+	struct Entry {
+		uint64_t timestamp;
+		SchedulerEvent event;
+	};
+
+	uint64_t now = 0;
+	uint64_t synchronized = 0;
+	uint64_t nextDeadline = Never;
+	uint32_t size = 0;
+	std::array<Entry, (size_t)SchedulerEvent::COUNT> heap;
+	std::array<int32_t, (size_t)SchedulerEvent::COUNT> positions;
+
+	void Swap(uint32_t a, uint32_t b);
+	void SiftUp(uint32_t index);
+	void SiftDown(uint32_t index);
+	void UpdateNextDeadline();
+};
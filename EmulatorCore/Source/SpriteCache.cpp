@@ -0,0 +1,21 @@
+#include "SpriteCache.h"
+#include <algorithm>
+
+SpriteCache::SpriteCache(const uint8_t* oam) : oam(oam) {}
+
+void SpriteCache::Rebuild(bool tallSprites) {
+	for (Line& line : lines) {
+		line.count = 0;
+	}
+	int32_t height = tallSprites ? 16 : 8;
+	for (uint8_t index = 0; index < 40; index++) {
+		int32_t top = oam[index * 4] - 16;
+		int32_t bottom = std::min<int32_t>(top + height, LineCount);
+		for (int32_t y = std::max(top, 0); y < bottom; y++) {
+			Line& line = lines[y];
+			if (line.count < MaxSpritesPerLine) line.sprites[line.count++] = index;
+		}
+	}
+	builtTall = tallSprites;
+	stale = false;
+}
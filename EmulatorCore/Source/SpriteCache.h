@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <array>
+
+// OAM indices of the sprites on every line, at most ten per line in OAM order,
+// as the PPU selects them during OAM scan. Only Y coordinates and the sprite
+// height decide the lists, so other OAM writes leave them valid.
+class SpriteCache {
+public:
+	static const uint32_t LineCount = 154;
+	static const uint32_t MaxSpritesPerLine = 10;
+
+	struct Line {
+		uint8_t count = 0;
+		std::array<uint8_t, MaxSpritesPerLine> sprites = {};
+	};
+
+	SpriteCache(const uint8_t* oam);
+
+	void Invalidate() { stale = true; }
+	void InvalidateY(uint32_t offset) {
+		if ((offset & 0b11) == 0) stale = true;
+	}
+
+	const Line& GetLine(uint8_t line, bool tallSprites) {
+		if (stale || tallSprites != builtTall) Rebuild(tallSprites);
+		return line < LineCount ? lines[line] : emptyLine;
+	}
+
+private:
+	const uint8_t* oam;
+	std::array<Line, LineCount> lines;
+	Line emptyLine;
+	bool builtTall = false;
+	bool stale = true;
+
+	void Rebuild(bool tallSprites);
+};
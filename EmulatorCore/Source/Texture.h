@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <vector>
+#include <cstring>
 
 struct Color {
 	float r = 0, g = 0, b = 0;
@@ -0,0 +1,96 @@
+#include "ThreadPool.h"
+
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local uint32_t currentWorker = 0;
+
+ThreadPool::ThreadPool(uint32_t threads) {
+	if (!threads) threads = 1;
+	for (uint32_t i = 0; i < threads; i++) {
+		workers.push_back(std::make_unique<Worker>());
+	}
+	for (uint32_t i = 0; i < threads; i++) {
+		this->threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+uint32_t ThreadPool::GetThreadCount() const {
+	return (uint32_t)workers.size();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+	unfinished++;
+	uint32_t index;
+	if (currentPool == this) {
+		index = currentWorker;
+	}
+	else {
+		std::lock_guard<std::mutex> lock(mutex);
+		index = nextWorker;
+		nextWorker = (nextWorker + 1) % workers.size();
+	}
+	{
+		std::lock_guard<std::mutex> lock(workers[index]->mutex);
+		workers[index]->tasks.push_back(std::move(task));
+	}
+	// Counting under the pool mutex keeps a worker from missing the task between
+	// checking the count and going to sleep.
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queued++;
+	}
+	wake.notify_one();
+}
+
+void ThreadPool::Wait() {
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return unfinished == 0; });
+}
+
+bool ThreadPool::TakeTask(uint32_t index, std::function<void()>& task) {
+	for (uint32_t i = 0; i < workers.size(); i++) {
+		Worker& worker = *workers[(index + i) % workers.size()];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.tasks.empty()) continue;
+		if (i == 0) {
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+		}
+		else {
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+		}
+		queued--;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::WorkerLoop(uint32_t index) {
+	currentPool = this;
+	currentWorker = index;
+	while (true) {
+		std::function<void()> task;
+		if (TakeTask(index, task)) {
+			task();
+			if (--unfinished == 0) {
+				std::lock_guard<std::mutex> lock(mutex);
+				done.notify_all();
+			}
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		wake.wait(lock, [this] { return stopping || queued > 0; });
+		if (stopping && queued == 0) return;
+	}
+}
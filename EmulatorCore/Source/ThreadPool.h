@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: every worker owns a task deque, takes new work from its
+// back and steals from the front of the other deques once its own runs dry.
+// Tasks submitted by a worker go to that worker's deque.
+class ThreadPool {
+public:
+	explicit ThreadPool(uint32_t threads);
+	~ThreadPool();
+
+	uint32_t GetThreadCount() const;
+	void Submit(std::function<void()> task);
+	// Blocks until every submitted task, including tasks submitted by tasks, finished.
+	void Wait();
+
+private:
+	struct Worker {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	std::atomic<uint32_t> queued = 0;
+	std::atomic<uint32_t> unfinished = 0;
+	uint32_t nextWorker = 0;
+	bool stopping = false;
+
+	bool TakeTask(uint32_t index, std::function<void()>& task);
+	void WorkerLoop(uint32_t index);
+};
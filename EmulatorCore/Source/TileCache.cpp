@@ -0,0 +1,23 @@
+#include "TileCache.h"
+#include "PixelKernels.h"
+
+TileCache::TileCache(const std::array<std::array<uint8_t, 0x2000>, 2>& vram) : vram(vram) {
+	InvalidateAll();
+}
+
+void TileCache::InvalidateAll() {
+	for (std::array<bool, TileCount>& bankStale : stale) {
+		bankStale.fill(true);
+	}
+}
+
+void TileCache::Invalidate(uint32_t bank, uint16_t offset, uint32_t size) {
+	for (uint32_t tile = offset >> 4; tile < TileCount && tile * 16 < offset + size; tile++) {
+		stale[bank][tile] = true;
+	}
+}
+
+void TileCache::Decode(uint32_t bank, uint32_t tile) {
+	PixelKernels::Get().decodeTile(&vram[bank][tile * 16], tiles[bank][0][tile].data(), tiles[bank][1][tile].data());
+	stale[bank][tile] = false;
+}
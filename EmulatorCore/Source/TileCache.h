@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <array>
+
+// Tiles of both VRAM banks decoded to one color number (0-3) per pixel, with a
+// horizontally flipped copy for sprites. VRAM writes only mark the tile stale,
+// it is decoded again the next time the PPU fetches a row from it.
+class TileCache {
+public:
+	static const uint32_t TileCount = 384;
+	static const uint32_t TileDataSize = TileCount * 16;
+
+	TileCache(const std::array<std::array<uint8_t, 0x2000>, 2>& vram);
+
+	void InvalidateAll();
+	void Invalidate(uint32_t bank, uint16_t offset) {
+		if (offset < TileDataSize) stale[bank][offset >> 4] = true;
+	}
+	void Invalidate(uint32_t bank, uint16_t offset, uint32_t size);
+
+	// Eight color numbers of one tile row, left to right as drawn. Tiles are
+	// numbered from 0x8000, so tile data at 0x8800-0x97ff is 128-383.
+	const uint8_t* GetRow(uint32_t bank, uint32_t tile, uint32_t row, bool xFlip) {
+		if (stale[bank][tile]) Decode(bank, tile);
+		return &tiles[bank][xFlip][tile][row * 8];
+	}
+
+private:
+	const std::array<std::array<uint8_t, 0x2000>, 2>& vram;
+	std::array<std::array<std::array<std::array<uint8_t, 64>, TileCount>, 2>, 2> tiles;
+	std::array<std::array<bool, TileCount>, 2> stale;
+
+	void Decode(uint32_t bank, uint32_t tile);
+};
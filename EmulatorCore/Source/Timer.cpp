@@ -1,6 +1,6 @@
 #include "Timer.h"
 
-std::array<uint32_t, 4> timaDividers = { 1024, 16, 64, 256 };
+static const std::array<uint32_t, 4> timaDividers = { 1024, 16, 64, 256 };
 
 Timer::Timer(Bus& bus) : bus(bus) {}
 
@@ -11,32 +11,49 @@ void Timer::Reset() {
 	TAC = 0xF8;
 	DIVClockAccumulator = 0;
 	TIMAClockAccumulator = 0;
+	synchronizedCycle = 0;
 }
 
-void Timer::Step(uint32_t cycles) {
-	DIVClockAccumulator += cycles;
-	uint8_t initialDIV = DIV;
-	DIV += DIVClockAccumulator >> 8;
-	DIVClockAccumulator &= 0xff;
+void Timer::Synchronize() {
+	uint64_t now = bus.scheduler.Now();
+	uint64_t cycles = now - synchronizedCycle;
+	if (!cycles) return;
+	synchronizedCycle = now;
+
+	uint64_t divCycles = DIVClockAccumulator + cycles;
+	DIV += (uint8_t)(divCycles >> 8);
+	DIVClockAccumulator = divCycles & 0xff;
 
 	if ((TAC & 0b100) == 0) return;
-	TIMAClockAccumulator += cycles;
 	uint32_t divider = timaDividers[TAC & 0b11];
-	while (TIMAClockAccumulator >= divider) {
-		TIMAClockAccumulator -= divider;
-		TIMA++;
-		if (TIMA == 0x00) {
-			TIMA = TMA;
-			bus.TriggerInterruption(Interruption::Timer);
-		}
+	uint64_t timaCycles = TIMAClockAccumulator + cycles;
+	uint64_t ticks = timaCycles / divider;
+	TIMAClockAccumulator = timaCycles % divider;
+	uint32_t ticksUntilOverflow = 0x100 - TIMA;
+	if (ticks < ticksUntilOverflow) {
+		TIMA += (uint8_t)ticks;
+		return;
 	}
+	// Every overflow reloads TMA, so only the ticks after the last one matter.
+	ticks -= ticksUntilOverflow;
+	TIMA = TMA + (uint8_t)(ticks % (0x100 - TMA));
+	bus.TriggerInterruption(Interruption::Timer);
+}
+
+uint32_t Timer::CyclesUntilEvent() {
+	Synchronize();
+	if ((TAC & 0b100) == 0) return 0;
+	int32_t cycles = (0x100 - TIMA) * timaDividers[TAC & 0b11] - TIMAClockAccumulator;
+	return cycles > 0 ? cycles : 1;
 }
 
 uint8_t Timer::ReadDIV() {
+	Synchronize();
 	return DIV;
 }
 
 uint8_t Timer::ReadTIMA() {
+	Synchronize();
 	return TIMA;
 }
 
@@ -49,24 +66,29 @@ uint8_t Timer::ReadTAC() {
 }
 
 void Timer::WriteDIV(uint8_t value) {
+	Synchronize();
 	DIV = 0;
 	DIVClockAccumulator = 0;
 	TIMAClockAccumulator = 0;
 }
 
 void Timer::WriteTIMA(uint8_t value) {
+	Synchronize();
 	TIMA = value;
 }
 
 void Timer::WriteTMA(uint8_t value) {
+	Synchronize();
 	TMA = value;
 }
 
 void Timer::WriteTAC(uint8_t value) {
+	Synchronize();
 	TAC = value;
 }
 
 void Timer::WriteState(SaveState& state) {
+	Synchronize();
 	state.Write8(DIV);
 	state.Write8(TIMA);
 	state.Write8(TMA);
@@ -82,4 +104,5 @@ void Timer::LoadState(SaveState& state) {
 	TAC = state.Read8();
 	DIVClockAccumulator = state.Read32();
 	TIMAClockAccumulator = state.Read32();
+	synchronizedCycle = bus.scheduler.Now();
 }
\ No newline at end of file
@@ -9,7 +9,10 @@ public:
 	Timer(Bus& bus);
 
 	void Reset();
-	void Step(uint32_t cycles);
+	// Derives DIV and TIMA at the scheduler's current cycle in constant time.
+	// Register accesses call it themselves, the bus only at scheduler deadlines.
+	void Synchronize();
+	uint32_t CyclesUntilEvent();
 
 	uint8_t ReadDIV();
 	uint8_t ReadTIMA();
@@ -31,5 +34,6 @@ private:
 	uint8_t TAC;
 	uint32_t DIVClockAccumulator;
 	uint32_t TIMAClockAccumulator;
+	uint64_t synchronizedCycle;
 };
 
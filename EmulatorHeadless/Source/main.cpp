@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BatchRunner.h"
+#include "GBCEmulator.h"
+#include "Log.h"
+
+struct Options {
+	std::vector<std::string> romPaths;
+	uint64_t frames = 600;
+	uint64_t cycles = 0;
+	std::string framePath;
+	std::string audioPath;
+	std::string dispatch;
+	std::string pixelFormat;
+	std::string frameSkip;
+	bool log = false;
+	uint32_t instances = 0;
+	uint32_t threads = 0;
+	bool scaling = false;
+	std::string ramDirectory;
+
+	bool IsBatch() const {
+		return instances || threads || scaling || !ramDirectory.empty() || romPaths.size() > 1;
+	}
+};
+
+void PrintUsage() {
+	std::cout << "Usage: EmulatorHeadless <rom> [options]\n"
+		<< "       EmulatorHeadless <rom>... [--instances k] [--threads n] [--scaling] [--ram-dir dir] [options]\n"
+		<< "  --frames <n>         run n frames (default 600)\n"
+		<< "  --cycles <n>         run n CPU cycles instead of frames\n"
+		<< "  --frame <file.ppm>   write the last frame\n"
+		<< "  --audio <file.wav>   write all generated audio\n"
+		<< "  --dispatch <mode>    switch, cached, threaded or jit\n"
+		<< "  --pixel-format <f>   rgba8 (default), rgb565 or index8\n"
+		<< "  --frame-skip <s>     n/m skips n < m of every m frames, adaptive:n skips up to n in a row\n"
+		<< "  --log                keep emulator output\n"
+		<< "Batch mode runs k instances of every ROM on a pool of n threads (default: all cores)\n"
+		<< "and prints frame and RAM hashes per instance.\n"
+		<< "  --scaling            repeat the batch on 1 to n threads and report scaling efficiency\n"
+		<< "  --ram-dir <dir>      write the RAM snapshot of every instance\n";
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (argument == "--frames" && hasValue) options.frames = std::stoull(argv[++i]);
+		else if (argument == "--cycles" && hasValue) options.cycles = std::stoull(argv[++i]);
+		else if (argument == "--frame" && hasValue) options.framePath = argv[++i];
+		else if (argument == "--audio" && hasValue) options.audioPath = argv[++i];
+		else if (argument == "--dispatch" && hasValue) options.dispatch = argv[++i];
+		else if (argument == "--pixel-format" && hasValue) options.pixelFormat = argv[++i];
+		else if (argument == "--frame-skip" && hasValue) options.frameSkip = argv[++i];
+		else if (argument == "--log") options.log = true;
+		else if (argument == "--instances" && hasValue) options.instances = std::stoul(argv[++i]);
+		else if (argument == "--threads" && hasValue) options.threads = std::stoul(argv[++i]);
+		else if (argument == "--scaling") options.scaling = true;
+		else if (argument == "--ram-dir" && hasValue) options.ramDirectory = argv[++i];
+		else if (argument.rfind("--", 0) != 0) options.romPaths.push_back(argument);
+		else {
+			std::cout << "Unknown argument: \"" << argument << "\"\n";
+			return false;
+		}
+	}
+	return !options.romPaths.empty();
+}
+
+bool ParseDispatch(const std::string& name, CPUDispatch& dispatch) {
+	if (name == "switch") dispatch = CPUDispatch::Switch;
+	else if (name == "cached") dispatch = CPUDispatch::Cached;
+	else if (name == "threaded") dispatch = CPUDispatch::Threaded;
+	else if (name == "jit") dispatch = CPUDispatch::JIT;
+	else return false;
+	return true;
+}
+
+bool ParsePixelFormat(const std::string& name, PixelFormat& format) {
+	if (name == "rgba8") format = PixelFormat::RGBA8;
+	else if (name == "rgb565") format = PixelFormat::RGB565;
+	else if (name == "index8") format = PixelFormat::Index8;
+	else return false;
+	return true;
+}
+
+bool ParseFrameSkip(const std::string& value, FrameSkipMode& mode, uint32_t& skip, uint32_t& interval) {
+	try {
+		size_t separator = value.find('/');
+		if (value.rfind("adaptive:", 0) == 0) {
+			mode = FrameSkipMode::Adaptive;
+			skip = std::stoul(value.substr(9));
+			interval = 1;
+		}
+		else if (separator != std::string::npos) {
+			mode = FrameSkipMode::Fixed;
+			skip = std::stoul(value.substr(0, separator));
+			interval = std::stoul(value.substr(separator + 1));
+			if (skip >= interval) return false;
+		}
+		else return false;
+	}
+	catch (const std::exception&) {
+		return false;
+	}
+	return true;
+}
+
+void WriteLittleEndian(std::ofstream& writer, uint32_t value, uint32_t bytes) {
+	for (uint32_t i = 0; i < bytes; i++) {
+		writer.put((char)((value >> (i * 8)) & 0xff));
+	}
+}
+
+bool WriteFrame(const std::string& path, const FrameBuffer& frame) {
+	std::ofstream writer(path, std::ios::out | std::ios::binary);
+	if (!writer) return false;
+	writer << "P6\n" << frame.width << " " << frame.height << "\n255\n";
+	for (uint32_t y = 0; y < frame.height; y++) {
+		for (uint32_t x = 0; x < frame.width; x++) {
+			uint32_t value = frame.GetPixel(x, y);
+			uint8_t rgb[3];
+			switch (frame.format) {
+			case PixelFormat::RGBA8:
+				memcpy(rgb, &value, sizeof(rgb));
+				break;
+			case PixelFormat::RGB565:
+				rgb[0] = (uint8_t)(((value >> 11) & 0x1f) * 255 / 0x1f);
+				rgb[1] = (uint8_t)(((value >> 5) & 0x3f) * 255 / 0x3f);
+				rgb[2] = (uint8_t)((value & 0x1f) * 255 / 0x1f);
+				break;
+			default:
+				memcpy(rgb, PPU::shadeColors[value & 0b11], sizeof(rgb));
+				break;
+			}
+			writer.write((const char*)rgb, sizeof(rgb));
+		}
+	}
+	return true;
+}
+
+// 16-bit stereo PCM at the SPU sample rate.
+bool WriteAudio(const std::string& path, const std::vector<int16_t>& samples) {
+	std::ofstream writer(path, std::ios::out | std::ios::binary);
+	if (!writer) return false;
+	uint32_t dataSize = (uint32_t)(samples.size() * sizeof(int16_t));
+	writer << "RIFF";
+	WriteLittleEndian(writer, 36 + dataSize, 4);
+	writer << "WAVEfmt ";
+	WriteLittleEndian(writer, 16, 4);
+	WriteLittleEndian(writer, 1, 2);
+	WriteLittleEndian(writer, 2, 2);
+	WriteLittleEndian(writer, spuSampleRate, 4);
+	WriteLittleEndian(writer, spuSampleRate * 2 * sizeof(int16_t), 4);
+	WriteLittleEndian(writer, 2 * sizeof(int16_t), 2);
+	WriteLittleEndian(writer, 16, 2);
+	writer << "data";
+	WriteLittleEndian(writer, dataSize, 4);
+	for (int16_t sample : samples) {
+		WriteLittleEndian(writer, (uint16_t)sample, 2);
+	}
+	return true;
+}
+
+int RunSingle(const Options& options) {
+	const std::string& romPath = options.romPaths[0];
+	std::shared_ptr<const ROMImage> rom = ROMImage::Open(romPath);
+	if (!rom) {
+		std::cout << "Could not open ROM file: \"" << romPath << "\"\n";
+		return 1;
+	}
+
+	GBCEmulator* emulator = new GBCEmulator();
+	if (!options.dispatch.empty() && !ParseDispatch(options.dispatch, emulator->cpu.dispatch)) {
+		std::cout << "Unknown dispatch mode: \"" << options.dispatch << "\"\n";
+		return 1;
+	}
+	PixelFormat pixelFormat = PixelFormat::RGBA8;
+	if (!options.pixelFormat.empty() && !ParsePixelFormat(options.pixelFormat, pixelFormat)) {
+		std::cout << "Unknown pixel format: \"" << options.pixelFormat << "\"\n";
+		return 1;
+	}
+	emulator->ppu.SetPixelFormat(pixelFormat);
+	FrameSkipMode frameSkipMode = FrameSkipMode::Off;
+	uint32_t frameSkip = 0, frameSkipInterval = 1;
+	if (!options.frameSkip.empty() && !ParseFrameSkip(options.frameSkip, frameSkipMode, frameSkip, frameSkipInterval)) {
+		std::cout << "Unknown frame skip: \"" << options.frameSkip << "\"\n";
+		return 1;
+	}
+	emulator->SetFrameSkip(frameSkipMode, frameSkip, frameSkipInterval);
+
+	if (!options.log) SetCoreLog(nullptr);
+	bool loaded = emulator->LoadROM(rom);
+	emulator->SetName(std::filesystem::path(romPath).filename().string());
+	if (!loaded) {
+		std::cout << "Could not load ROM: \"" << romPath << "\"\n";
+		return 1;
+	}
+
+	uint64_t cycles = options.cycles ? options.cycles : options.frames * GBCEmulator::FrameCycles;
+	std::vector<int16_t> audio;
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t elapsed = 0; elapsed < cycles;) {
+		uint32_t frameCycles = (uint32_t)std::min<uint64_t>(GBCEmulator::FrameCycles, cycles - elapsed);
+		emulator->Run(frameCycles);
+		elapsed += frameCycles;
+
+		// ClearSamples keeps the samples past the last multiple of 8 for the next frame.
+		uint32_t samples = emulator->spu.GetSamplesCount();
+		if (!options.audioPath.empty()) {
+			samples -= samples % 8;
+			audio.insert(audio.end(), emulator->spu.GetSamples(), emulator->spu.GetSamples() + samples);
+		}
+		emulator->spu.ClearSamples();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	double frames = (double)cycles / GBCEmulator::FrameCycles;
+	std::cout << std::fixed << std::setprecision(2)
+		<< "rom          " << emulator->GetROMName() << "\n"
+		<< "frames       " << frames << "\n"
+		<< "cycles       " << cycles << "\n"
+		<< "wall time    " << seconds << " s\n"
+		<< "fps          " << frames / seconds << " (" << frames / seconds / 60.0 << "x)\n"
+		<< "clock        " << cycles / seconds / 1000000.0 << " MHz\n"
+		<< "idle skipped " << emulator->cpu.idleCyclesSkipped * 100.0 / cycles << "%\n";
+#ifdef GBC_IO_STATS
+	std::cout << "\n";
+	emulator->bus.PrintIOStats(std::cout);
+#endif
+
+	bool written = true;
+	if (!options.framePath.empty() && !WriteFrame(options.framePath, emulator->ppu.frameBuffers[!emulator->ppu.activeFrame])) {
+		std::cout << "Could not write frame: \"" << options.framePath << "\"\n";
+		written = false;
+	}
+	if (!options.audioPath.empty() && !WriteAudio(options.audioPath, audio)) {
+		std::cout << "Could not write audio: \"" << options.audioPath << "\"\n";
+		written = false;
+	}
+
+	delete emulator;
+	return written ? 0 : 1;
+}
+
+double RunBatch(BatchRunner& runner, const std::vector<BatchInstance>& instances, uint32_t frames, std::vector<BatchResult>& results) {
+	auto start = std::chrono::steady_clock::now();
+	results = runner.Run(instances, frames);
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int RunBatch(const Options& options) {
+	if (options.cycles || !options.framePath.empty() || !options.audioPath.empty() || !options.pixelFormat.empty()) {
+		std::cout << "--cycles, --frame, --audio and --pixel-format only apply to a single instance.\n";
+		return 1;
+	}
+	CPUDispatch dispatch = CPU::DefaultDispatch;
+	if (!options.dispatch.empty() && !ParseDispatch(options.dispatch, dispatch)) {
+		std::cout << "Unknown dispatch mode: \"" << options.dispatch << "\"\n";
+		return 1;
+	}
+	FrameSkipMode frameSkipMode = FrameSkipMode::Off;
+	uint32_t frameSkip = 0, frameSkipInterval = 1;
+	if (!options.frameSkip.empty() && !ParseFrameSkip(options.frameSkip, frameSkipMode, frameSkip, frameSkipInterval)) {
+		std::cout << "Unknown frame skip: \"" << options.frameSkip << "\"\n";
+		return 1;
+	}
+
+	std::vector<std::shared_ptr<const ROMImage>> roms(options.romPaths.size());
+	for (size_t i = 0; i < options.romPaths.size(); i++) {
+		roms[i] = ROMImage::Open(options.romPaths[i]);
+		if (!roms[i]) {
+			std::cout << "Could not open ROM file: \"" << options.romPaths[i] << "\"\n";
+			return 1;
+		}
+	}
+	std::vector<BatchInstance> instances;
+	uint32_t copies = options.instances ? options.instances : 1;
+	for (uint32_t copy = 0; copy < copies; copy++) {
+		for (size_t i = 0; i < roms.size(); i++) {
+			BatchInstance instance;
+			instance.name = std::filesystem::path(options.romPaths[i]).filename().string() + "#" + std::to_string(copy);
+			instance.rom = roms[i];
+			instance.dispatch = dispatch;
+			instance.frameSkipMode = frameSkipMode;
+			instance.frameSkip = frameSkip;
+			instance.frameSkipInterval = frameSkipInterval;
+			instances.push_back(instance);
+		}
+	}
+
+	uint32_t threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+	uint32_t frames = (uint32_t)options.frames;
+	double totalFrames = (double)frames * instances.size();
+	std::vector<BatchResult> results;
+	BatchRunner runner(threads);
+	double seconds = RunBatch(runner, instances, frames, results);
+
+	bool failed = false;
+	std::cout << std::left << std::setw(32) << "instance" << std::setw(18) << "frame hash" << std::setw(18) << "ram hash"
+		<< std::right << std::setw(10) << "seconds" << std::setw(10) << "fps" << "\n";
+	for (size_t i = 0; i < results.size(); i++) {
+		const BatchResult& result = results[i];
+		std::cout << std::left << std::setw(32) << result.name;
+		if (!result.loaded) {
+			std::cout << "could not load ROM\n";
+			failed = true;
+			continue;
+		}
+		std::cout << std::hex << std::setfill('0') << std::right << std::setw(16) << result.frameHash << "  " << std::setw(16) << result.ramHash
+			<< std::dec << std::setfill(' ') << std::fixed << std::setprecision(2) << std::setw(10) << result.seconds << std::setw(10) << frames / result.seconds << "\n";
+		if (!options.ramDirectory.empty()) {
+			std::filesystem::path path = std::filesystem::path(options.ramDirectory) / (result.name + ".ram");
+			std::ofstream writer(path, std::ios::out | std::ios::binary);
+			writer.write((const char*)result.ram.data(), result.ram.size());
+			if (!writer) {
+				std::cout << "Could not write RAM snapshot: \"" << path.string() << "\"\n";
+				failed = true;
+			}
+		}
+	}
+	std::cout << std::fixed << std::setprecision(2)
+		<< "instances    " << instances.size() << "\n"
+		<< "threads      " << runner.GetThreadCount() << "\n"
+		<< "wall time    " << seconds << " s\n"
+		<< "fps          " << totalFrames / seconds << " (" << totalFrames / seconds / 60.0 << "x)\n";
+
+	if (options.scaling) {
+		std::cout << "\n" << std::left << std::setw(10) << "threads" << std::right << std::setw(12) << "fps" << std::setw(12) << "speedup" << std::setw(12) << "efficiency" << "\n";
+		double baseFPS = 0;
+		for (uint32_t count = 1; count <= threads; count++) {
+			BatchRunner scalingRunner(count);
+			double fps = totalFrames / RunBatch(scalingRunner, instances, frames, results);
+			if (count == 1) baseFPS = fps;
+			std::cout << std::left << std::setw(10) << count << std::right << std::setw(12) << fps
+				<< std::setw(11) << fps / baseFPS << "x" << std::setw(11) << fps / baseFPS / count * 100.0 << "%\n";
+		}
+	}
+	return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return 1;
+	}
+	return options.IsBatch() ? RunBatch(options) : RunSingle(options);
+}